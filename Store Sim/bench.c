@@ -0,0 +1,618 @@
+/**
+ * Benchmarks for every stage of the Wackman pipeline.
+ *
+ * Usage: ./bench [megabytes] [max threads] [file...]
+ *
+ * Each stage is run over these corpora, each `megabytes` long (256 by
+ * default):
+ *
+ *   beanstalk   JACK_AND_THE_BEANSTALK repeated
+ *   uniform     every byte value equally likely
+ *   zipf        byte k has probability proportional to 1 / (k + 1)
+ *   single      one byte value only
+ *   skewed      byte k has probability 2^-(k + 1), so codes need limiting
+ *
+ * plus every file named on the command line, read whole. The stages are the
+ * byte histograms, tree construction (linked list and heap), code and decode
+ * table generation, encoding and decoding in one stream and in 1, 2, 4
+ * and 8 interleaved streams (with codes limited to
+ * WACKY_INTERLEAVE_MAX_LENGTH bits), and the parallel codec with 1, 2, 4, ...
+ * threads up to `max threads` (one per core by default). On the
+ * beanstalk corpus the table encoder is also timed over the whole corpus
+ * against the original tree-search encoder over its first
+ * REFERENCE_BENCH_BYTES (each row's `bytes` says which), and
+ * BATCH_RECORD_BYTES-byte records are coded one message at a time and as one
+ * batch.
+ *
+ * Every decoded output is compared with its input. Results are printed as CSV
+ * with one row per corpus and stage:
+ *
+ *   corpus,stage,calls,bytes,seconds,mb_per_s,ns_per_symbol,ns_per_call
+ *
+ * `bytes` is the input size per call, and it is 0 for stages that do not
+ * depend on the input size. Those rows leave the per-byte columns empty.
+ *
+ * Build with: gcc -O2 -pthread bench.c -o bench -lm
+ */
+
+#include <time.h>
+
+#include "beanstalk.c"
+#include "wacky_batch.c"
+#include "wacky_codes.c"
+#include "wacky_histogram.c"
+#include "wacky_interleave.c"
+#include "wacky_parallel.c"
+
+#define BITS_PER_INT (sizeof(int) * CHAR_BIT)
+#define DEFAULT_BENCH_MEGABYTES 256
+// The tree-search encoder runs at a few MB/s, so it only gets a slice; the
+// table encoder it is compared with runs over the whole corpus.
+#define REFERENCE_BENCH_BYTES ((size_t)16 * 1000 * 1000)
+// Stages that do not touch the input are repeated for at least this long.
+#define MIN_BENCH_SECONDS 0.1
+// The records of the batch stages.
+#define BATCH_RECORD_BYTES 32
+#define MAX_BATCH_RECORDS ((size_t)1000 * 1000)
+
+/**
+ * A copy of encode_string() from main.c, minus the trailing printf, so the
+ * benchmark measures the tree-search path as it stands.
+ */
+int* encode_string_reference(WackyTreeNode* tree, char* string) {
+    if (tree == NULL || string == NULL || string[0] == '\0') {
+        return NULL;
+    }
+
+    int int_buffer_size = 1;
+    int* return_int_buffer = calloc(1 + int_buffer_size, sizeof(int));
+    int* write_int_buffer = &return_int_buffer[1];
+
+    int height_of_tree = get_height(tree);
+    bool* boolean_array = malloc(height_of_tree * sizeof(bool));
+    int boolean_array_length = 0;
+
+    int string_index = 0;
+    int bit_index = 0;
+
+    while (string[string_index] != '\0') {
+        char character = string[string_index];
+
+        get_wacky_code(tree, character, boolean_array, &boolean_array_length);
+        if (boolean_array_length < 0) {
+            printf("Could not find coding for '%c', aborting...\n", character);
+            free(boolean_array);
+            free(return_int_buffer);
+            return NULL;
+        }
+
+        for (int i = 0; i < boolean_array_length; i++) {
+            int int_buffer_idx = bit_index / BITS_PER_INT;
+            if (int_buffer_idx >= int_buffer_size) {
+                int old_buffer_size = int_buffer_size;
+                int_buffer_size = old_buffer_size * 2;
+                return_int_buffer = realloc(
+                    return_int_buffer, (1 + int_buffer_size) * sizeof(int));
+                write_int_buffer = &return_int_buffer[1];
+                memset(&write_int_buffer[old_buffer_size], 0,
+                       old_buffer_size * sizeof(int));
+            }
+
+            if (boolean_array[i]) {
+                int next_val = write_int_buffer[int_buffer_idx];
+                int int_bit_idx = (bit_index % BITS_PER_INT);
+                next_val = setBit(next_val, int_bit_idx);
+                write_int_buffer[int_buffer_idx] = next_val;
+            }
+
+            bit_index++;
+        }
+
+        string_index++;
+    }
+
+    free(boolean_array);
+    return_int_buffer[0] = string_index;
+    return return_int_buffer;
+}
+
+double elapsed_seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+double now_seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Prints one CSV row. `bytes` is the input size of each of the `calls`.
+ */
+void report(const char* corpus, const char* stage, size_t calls, size_t bytes,
+            double seconds) {
+    printf("%s,%s,%zu,%zu,%.6f,", corpus, stage, calls, bytes, seconds);
+    if (bytes > 0) {
+        double total = (double)bytes * calls;
+        printf("%.2f,%.3f,", total / seconds / 1e6, seconds * 1e9 / total);
+    } else {
+        printf(",,");
+    }
+    printf("%.1f\n", seconds * 1e9 / calls);
+}
+
+/**
+ * Fills a new buffer of `size` bytes by repeating `corpus`.
+ */
+char* make_corpus(const char* corpus, size_t size) {
+    size_t corpus_length = strlen(corpus);
+    char* buffer = malloc(size + 1);
+    if (buffer == NULL) {
+        return NULL;
+    }
+    for (size_t offset = 0; offset < size; offset += corpus_length) {
+        memcpy(&buffer[offset], corpus, MIN(corpus_length, size - offset));
+    }
+    buffer[size] = '\0';
+    return buffer;
+}
+
+/**
+ * A small, fixed-seed generator so every run benchmarks the same bytes.
+ */
+static inline uint64_t next_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+typedef enum {
+    CORPUS_UNIFORM,
+    CORPUS_ZIPF,
+    CORPUS_SINGLE,
+    CORPUS_SKEWED,
+} SyntheticCorpus;
+
+/**
+ * Fills a new buffer of `size` bytes drawn from one of the synthetic
+ * distributions.
+ */
+uint8_t* make_synthetic_corpus(SyntheticCorpus kind, size_t size) {
+    uint8_t* buffer = malloc(MAX(size, 1));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    double cdf[WACKY_BYTE_ALPHABET_SIZE];
+    double total = 0;
+    for (int k = 0; k < WACKY_BYTE_ALPHABET_SIZE; k++) {
+        total += 1.0 / (k + 1);
+        cdf[k] = total;
+    }
+
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < size; i++) {
+        uint64_t random = next_random(&state);
+        switch (kind) {
+            case CORPUS_UNIFORM:
+                buffer[i] = (uint8_t)(random >> 56);
+                break;
+            case CORPUS_ZIPF: {
+                double target = (random >> 11) * 0x1.0p-53 * total;
+                int low = 0, high = WACKY_BYTE_ALPHABET_SIZE - 1;
+                while (low < high) {
+                    int middle = (low + high) / 2;
+                    if (cdf[middle] < target) {
+                        low = middle + 1;
+                    } else {
+                        high = middle;
+                    }
+                }
+                buffer[i] = low;
+                break;
+            }
+            case CORPUS_SINGLE:
+                buffer[i] = 'a';
+                break;
+            case CORPUS_SKEWED:
+                buffer[i] = random == 0 ? 63 : __builtin_ctzll(random);
+                break;
+        }
+    }
+    return buffer;
+}
+
+/**
+ * Reads a whole file into a new buffer.
+ */
+uint8_t* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    uint8_t* buffer = NULL;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long length = ftell(file);
+        rewind(file);
+        buffer = length >= 0 ? malloc(MAX(length, 1)) : NULL;
+        *size = length;
+        if (buffer != NULL && fread(buffer, 1, *size, file) != *size) {
+            free(buffer);
+            buffer = NULL;
+        }
+    }
+    fclose(file);
+    return buffer;
+}
+
+/**
+ * Times the stages that depend only on the histogram by repeating each one
+ * for at least MIN_BENCH_SECONDS.
+ */
+void bench_tables(const char* corpus, const uint64_t counts[],
+                  bool is_ascii) {
+    size_t calls;
+    double start;
+
+    if (is_ascii) {
+        int occurrence_array[WACKY_BYTE_ALPHABET_SIZE];
+        counts_to_occurrence_array(counts, occurrence_array);
+        start = now_seconds();
+        for (calls = 0; now_seconds() - start < MIN_BENCH_SECONDS; calls++) {
+            free_tree(merge_wacky_list(create_wacky_list(occurrence_array)));
+        }
+        report(corpus, "tree_linked_list", calls, 0, now_seconds() - start);
+    }
+
+    WackyArena* arena = new_wacky_arena(WACKY_BYTE_ALPHABET_SIZE);
+    start = now_seconds();
+    for (calls = 0; now_seconds() - start < MIN_BENCH_SECONDS; calls++) {
+        arena->tree_used = 0;
+        build_wacky_tree_from_counts(arena, counts, WACKY_BYTE_ALPHABET_SIZE);
+    }
+    report(corpus, "tree_heap", calls, 0, now_seconds() - start);
+    free_wacky_arena(arena);
+
+    WackyCodeTable codes;
+    start = now_seconds();
+    for (calls = 0; now_seconds() - start < MIN_BENCH_SECONDS; calls++) {
+        build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH, &codes);
+    }
+    report(corpus, "code_table", calls, 0, now_seconds() - start);
+
+    WackyDecodeTable table;
+    start = now_seconds();
+    for (calls = 0; now_seconds() - start < MIN_BENCH_SECONDS; calls++) {
+        build_wacky_decode_table(&codes, &table);
+        free_wacky_decode_table(&table);
+    }
+    report(corpus, "decode_table", calls, 0, now_seconds() - start);
+}
+
+/**
+ * Runs every stage over one corpus.
+ *
+ * @return false if a round trip does not reproduce the input.
+ */
+bool bench_corpus(const char* corpus, const uint8_t* data, size_t size,
+                  int max_threads) {
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    compute_byte_histogram(counts, data, size);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    report(corpus, "histogram", 1, size, elapsed_seconds(start, end));
+
+    // The naive histogram counts into int, so it is only run, and compared,
+    // where no count can overflow.
+    if (size <= INT_MAX) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int occurrences[WACKY_BYTE_ALPHABET_SIZE];
+        compute_byte_occurrence_array(occurrences, data, size);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        report(corpus, "histogram_naive", 1, size,
+               elapsed_seconds(start, end));
+        for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+            if (counts[i] != (uint64_t)occurrences[i]) {
+                printf("%s: histograms disagree!\n", corpus);
+                return false;
+            }
+        }
+    }
+
+    bool is_ascii = true;
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        if (i >= ASCII_CHARACTER_SET_SIZE && counts[i] > 0) {
+            is_ascii = false;
+        }
+    }
+    if (size == 0) {
+        return true;
+    }
+    bench_tables(corpus, counts, is_ascii);
+
+    WackyCodeTable codes;
+    WackyDecodeTable table;
+    if (!build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH, &codes) ||
+        !build_wacky_decode_table(&codes, &table)) {
+        printf("%s: could not build the tables!\n", corpus);
+        return false;
+    }
+    size_t capacity = (count_encoded_bits(&codes, counts) + CHAR_BIT - 1) /
+                      CHAR_BIT;
+    uint8_t* encoded = malloc(MAX(capacity, 1));
+    uint8_t* decoded = malloc(size);
+    size_t encoded_size = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool ok = encoded != NULL && decoded != NULL &&
+              encode_bytes_to_stream(&codes, data, size, encoded, capacity,
+                                     &encoded_size);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    report(corpus, "encode", 1, size, elapsed_seconds(start, end));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ok = ok &&
+         decode_bytes_with_table(&table, encoded, encoded_size, decoded, size);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    report(corpus, "decode", 1, size, elapsed_seconds(start, end));
+    free(encoded);
+    ok = ok && memcmp(decoded, data, size) == 0;
+
+    // Interleaved payloads are coded with lengths limited to the root table,
+    // so they decode in the one-lookup loop.
+    free_wacky_decode_table(&table);
+    bool limited = ok &&
+                   build_canonical_byte_table(counts,
+                                              WACKY_INTERLEAVE_MAX_LENGTH,
+                                              &codes) &&
+                   build_wacky_decode_table(&codes, &table);
+    capacity = wacky_interleaved_bound(size, codes.max_length,
+                                       WACKY_MAX_INTERLEAVE_STREAMS);
+    encoded = limited ? malloc(capacity) : NULL;
+    ok = encoded != NULL;
+    for (int streams = 1; ok && streams <= 8; streams *= 2) {
+        char stage[32];
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ok = encode_bytes_interleaved(&codes, data, size, streams, encoded,
+                                      capacity, &encoded_size);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        snprintf(stage, sizeof(stage), "interleaved_encode_x%d", streams);
+        report(corpus, stage, 1, size, elapsed_seconds(start, end));
+
+        memset(decoded, 0, size);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ok = ok && decode_bytes_interleaved(&table, encoded, encoded_size,
+                                            decoded, size);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        snprintf(stage, sizeof(stage), "interleaved_decode_x%d", streams);
+        report(corpus, stage, 1, size, elapsed_seconds(start, end));
+        ok = ok && memcmp(decoded, data, size) == 0;
+    }
+    if (limited) {
+        free_wacky_decode_table(&table);
+    }
+    free(encoded);
+
+    if (!ok || memcmp(decoded, data, size) != 0) {
+        printf("%s: round trip failed!\n", corpus);
+        free(decoded);
+        return false;
+    }
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        char stage[32];
+        WackyParallelEncoding encoding;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bool encoded = wacky_parallel_encode(data, size, 0, threads, &encoding);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        snprintf(stage, sizeof(stage), "parallel_encode_x%d", threads);
+        report(corpus, stage, 1, size, elapsed_seconds(start, end));
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ok = encoded && wacky_parallel_decode(&encoding, decoded, threads);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        snprintf(stage, sizeof(stage), "parallel_decode_x%d", threads);
+        report(corpus, stage, 1, size, elapsed_seconds(start, end));
+
+        if (encoded) {
+            free_wacky_parallel_encoding(&encoding);
+        }
+        if (!ok || memcmp(decoded, data, size) != 0) {
+            printf("%s: parallel round trip failed!\n", corpus);
+            free(decoded);
+            return false;
+        }
+    }
+    free(decoded);
+    return true;
+}
+
+/**
+ * Times the table encoder over the whole corpus and the tree-search encoder it
+ * replaced over the first REFERENCE_BENCH_BYTES, and checks that they produce
+ * the same bits for the bytes both encoded.
+ */
+bool bench_reference_encoder(char* input, size_t size) {
+    size_t reference_size = MIN(size, REFERENCE_BENCH_BYTES);
+
+    int occurrence_array[ASCII_CHARACTER_SET_SIZE];
+    compute_occurrence_array(occurrence_array, (char*)JACK_AND_THE_BEANSTALK);
+    WackyTreeNode* tree = merge_wacky_list(create_wacky_list(occurrence_array));
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    WackyCodeTable table;
+    build_wacky_code_table(tree, &table);
+    int* fast = encode_string_with_table(&table, input);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    report("beanstalk", "encode_string_with_table", 1, size,
+           elapsed_seconds(start, end));
+
+    char saved = input[reference_size];
+    input[reference_size] = '\0';
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int* reference = encode_string_reference(tree, input);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    input[reference_size] = saved;
+    report("beanstalk", "encode_string", 1, reference_size,
+           elapsed_seconds(start, end));
+
+    // The table encoder went on past the reference, so only the bits of the
+    // first reference_size bytes are compared, masking the last word.
+    size_t total_bits = 0;
+    for (size_t i = 0; i < reference_size; i++) {
+        total_bits += table.codes[(unsigned char)input[i]].length;
+    }
+    size_t whole_words = total_bits / BITS_PER_INT;
+    unsigned int last_bits = total_bits % BITS_PER_INT;
+    bool same = fast != NULL && reference != NULL &&
+                memcmp(&fast[1], &reference[1], whole_words * sizeof(int)) ==
+                    0;
+    if (same && last_bits > 0) {
+        unsigned int mask = (1u << last_bits) - 1;
+        same = ((unsigned int)fast[1 + whole_words] & mask) ==
+               ((unsigned int)reference[1 + whole_words] & mask);
+    }
+    if (!same) {
+        printf("beanstalk: encoders disagree!\n");
+    }
+
+    free(fast);
+    free(reference);
+    free_tree(tree);
+    return same;
+}
+
+/**
+ * Times short records coded one message at a time against the same records
+ * coded as one batch, and checks that both decode back to the input. The
+ * input is cut into records of BATCH_RECORD_BYTES, and each row reports the
+ * time per record.
+ */
+bool bench_records(const char* corpus, const uint8_t* data, size_t size) {
+    size_t count = MIN(size / BATCH_RECORD_BYTES, MAX_BATCH_RECORDS);
+    size = count * BATCH_RECORD_BYTES;
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    compute_byte_histogram(counts, data, size);
+    WackyEncoderContext encoder;
+    WackyDecoderContext decoder;
+    if (count == 0 || !wacky_encoder_init_from_counts(&encoder, counts) ||
+        !wacky_decoder_init(&decoder, &encoder.codes)) {
+        return count == 0;
+    }
+
+    WackyRecord* records = malloc(count * sizeof(WackyRecord));
+    size_t* offsets = malloc((count + 1) * sizeof(size_t));
+    size_t capacity = count * wacky_message_bound(&encoder, BATCH_RECORD_BYTES);
+    uint8_t* encoded = malloc(capacity);
+    uint8_t* decoded = malloc(size);
+    bool ok = records != NULL && offsets != NULL && encoded != NULL &&
+              decoded != NULL;
+    for (size_t i = 0; ok && i < count; i++) {
+        records[i].data = &data[i * BATCH_RECORD_BYTES];
+        records[i].length = BATCH_RECORD_BYTES;
+    }
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    offsets[0] = 0;
+    for (size_t i = 0; ok && i < count; i++) {
+        size_t written = wacky_encode_message(
+            &encoder, records[i].data, records[i].length, &encoded[offsets[i]],
+            capacity - offsets[i]);
+        offsets[i + 1] = offsets[i] + written;
+        ok = written > 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    report(corpus, "message_encode", count, BATCH_RECORD_BYTES,
+           elapsed_seconds(start, end));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t i = 0; ok && i < count; i++) {
+        size_t length;
+        ok = wacky_decode_message(&decoder, &encoded[offsets[i]],
+                                  offsets[i + 1] - offsets[i],
+                                  &decoded[i * BATCH_RECORD_BYTES],
+                                  BATCH_RECORD_BYTES, &length);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    report(corpus, "message_decode", count, BATCH_RECORD_BYTES,
+           elapsed_seconds(start, end));
+    ok = ok && memcmp(decoded, data, size) == 0;
+
+    size_t batch_size = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (ok) {
+        batch_size = wacky_encode_batch(&encoder, records, count, encoded,
+                                        capacity);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    report(corpus, "batch_encode", count, BATCH_RECORD_BYTES,
+           elapsed_seconds(start, end));
+
+    memset(decoded, 0, size);
+    size_t decoded_count;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ok = batch_size > 0 &&
+         wacky_decode_batch(&decoder, encoded, batch_size, decoded, size,
+                            records, count, &decoded_count);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    report(corpus, "batch_decode", count, BATCH_RECORD_BYTES,
+           elapsed_seconds(start, end));
+    ok = ok && decoded_count == count && memcmp(decoded, data, size) == 0;
+
+    if (!ok) {
+        printf("%s: record round trip failed!\n", corpus);
+    }
+    wacky_decoder_free(&decoder);
+    free(records);
+    free(offsets);
+    free(encoded);
+    free(decoded);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = DEFAULT_BENCH_MEGABYTES;
+    if (argc > 1) {
+        megabytes = strtoul(argv[1], NULL, 10);
+    }
+    // The legacy format stores the length in an int.
+    size_t size = MIN(megabytes * 1000 * 1000, (size_t)INT_MAX);
+    int max_threads = resolve_thread_count(argc > 2 ? atoi(argv[2]) : 0);
+
+    printf("corpus,stage,calls,bytes,seconds,mb_per_s,ns_per_symbol,"
+           "ns_per_call\n");
+
+    char* beanstalk = make_corpus(JACK_AND_THE_BEANSTALK, size);
+    if (beanstalk == NULL) {
+        printf("Could not allocate %zu bytes.\n", size);
+        return 1;
+    }
+    bool ok = bench_reference_encoder(beanstalk, size) &&
+              bench_corpus("beanstalk", (const uint8_t*)beanstalk, size,
+                           max_threads) &&
+              bench_records("beanstalk", (const uint8_t*)beanstalk, size);
+    free(beanstalk);
+
+    const char* names[] = {"uniform", "zipf", "single", "skewed"};
+    for (int kind = CORPUS_UNIFORM; ok && kind <= CORPUS_SKEWED; kind++) {
+        uint8_t* data = make_synthetic_corpus(kind, size);
+        ok = data != NULL && bench_corpus(names[kind], data, size, max_threads);
+        free(data);
+    }
+
+    for (int i = 3; ok && i < argc; i++) {
+        size_t file_size;
+        uint8_t* data = read_file(argv[i], &file_size);
+        if (data == NULL) {
+            printf("Could not read '%s'.\n", argv[i]);
+            return 1;
+        }
+        ok = bench_corpus(argv[i], data, file_size, max_threads);
+        free(data);
+    }
+    return ok ? 0 : 1;
+}
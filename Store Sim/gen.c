@@ -0,0 +1,48 @@
+/**
+ * Generates a static codec from a dictionary.
+ *
+ * Usage: ./gen dictionary name output
+ *
+ * The code table in `dictionary` (see wacky_train.c) is turned into C source
+ * for name_encode() and name_decode() with constant tables, written to
+ * `output` (see wacky_generate.c). A dictionary of `beanstalk` stands for the
+ * table train would build from JACK_AND_THE_BEANSTALK alone.
+ *
+ * Build with: gcc -O2 gen.c -o gen -lm
+ */
+
+#include "beanstalk.c"
+#include "wacky_generate.c"
+#include "wacky_train.c"
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        printf("Usage: %s dictionary name output\n", argv[0]);
+        return 1;
+    }
+
+    WackyCodeTable table;
+    if (strcmp(argv[1], "beanstalk") == 0) {
+        WackyTrainer trainer;
+        wacky_trainer_init(&trainer);
+        wacky_trainer_add(&trainer, (const uint8_t*)JACK_AND_THE_BEANSTALK,
+                          strlen(JACK_AND_THE_BEANSTALK));
+        wacky_trainer_build_table(&trainer, WACKY_MAX_DECODE_LENGTH, true,
+                                  &table);
+    } else if (!wacky_load_dictionary(argv[1], &table)) {
+        printf("Could not read '%s'.\n", argv[1]);
+        return 1;
+    }
+
+    char origin[256];
+    snprintf(origin, sizeof(origin), "Generated by: %s %s %s %s", argv[0],
+             argv[1], argv[2], argv[3]);
+    FILE* out = fopen(argv[3], "w");
+    bool ok = out != NULL && write_static_codec(out, argv[2], &table, origin);
+    if (out == NULL || fclose(out) != 0 || !ok) {
+        printf("Could not write '%s'.\n", argv[3]);
+        return 1;
+    }
+    printf("Wrote %s, longest code %d bits.\n", argv[3], table.max_length);
+    return 0;
+}
@@ -22,6 +22,7 @@
 
 #include "beanstalk.c"
 #include "wackman.c"
+#include "wacky_codes.c"
 
 #define BITS_PER_INT (sizeof(int) * CHAR_BIT)
 #define PRINT_TREE_SPACING 10
@@ -80,69 +81,14 @@ int* encode_string(WackyTreeNode* tree, char* string) {
         return NULL;
     }
 
-    // These variables store information regarding the write buffer.
-    int int_buffer_size = 1;
-
-    // We need a padding at the start, to store length.
-    int* return_int_buffer = calloc(1 + int_buffer_size, sizeof(int));
-    int* write_int_buffer = &return_int_buffer[1];
-
-    // Compute the max padding required from tree's height.
-    int height_of_tree = get_height(tree);
-    bool* boolean_array = malloc(height_of_tree * sizeof(bool));
-    int boolean_array_length = 0;
-
-    // Read from the string, until end of line delimiter.
-    int string_index = 0;
-    int bit_index = 0;
-
-    while (string[string_index] != '\0') {
-        char character = string[string_index];
-
-        // Get the coding for this specific character.
-        get_wacky_code(tree, character, boolean_array, &boolean_array_length);
-        if (boolean_array_length < 0) {
-            printf("Could not find coding for '%c', aborting...\n", character);
-            free(boolean_array);
-            free(return_int_buffer);
-            return NULL;
-        }
-
-        // Write the coding to the int buffer.
-        for (int i = 0; i < boolean_array_length; i++) {
-            int int_buffer_idx = bit_index / BITS_PER_INT;
-            if (int_buffer_idx >= int_buffer_size) {
-                // Current buffer not big enough. Expand by 2x.
-                int old_buffer_size = int_buffer_size;
-                int_buffer_size = old_buffer_size * 2;
-                return_int_buffer = realloc(
-                    return_int_buffer, (1 + int_buffer_size) * sizeof(int));
-                write_int_buffer = &return_int_buffer[1];
-                memset(&write_int_buffer[old_buffer_size], 0,
-                       old_buffer_size * sizeof(int));
-            }
-
-            // Originally, all bits are FALSE.
-            // If TRUE, set the i_th bit to TRUE.
-            if (boolean_array[i]) {
-                int next_val = write_int_buffer[int_buffer_idx];
-                int int_bit_idx = (bit_index % BITS_PER_INT);
-                next_val = setBit(next_val, int_bit_idx);
-                write_int_buffer[int_buffer_idx] = next_val;
-            }
-
-            bit_index++;
-        }
-
-        string_index++;
+    // One walk over the tree gives every code; each character is then a
+    // single table lookup instead of a search of the tree.
+    WackyCodeTable table;
+    if (!build_wacky_code_table(tree, &table)) {
+        return NULL;
     }
-
-    // No need the allocated boolean_array anymore. Free it.
-    free(boolean_array);
+    int* return_int_buffer = encode_string_with_table(&table, string);
     printf("\n");
-
-    // Recall that return_int_buffer has a padding. Set the string length.
-    return_int_buffer[0] = string_index;
     return return_int_buffer;
 }
 
@@ -0,0 +1,62 @@
+/**
+ * Builds a static dictionary from sample files.
+ *
+ * Usage: ./train [-l max_length] dictionary sample...
+ *
+ * Every sample is added to one histogram, and the resulting code table is
+ * written to `dictionary` (see wacky_train.c). Every byte value gets a code,
+ * so any message can be encoded with the dictionary later. Codes are at most
+ * `max_length` bits long, from 1 to WACKY_MAX_DECODE_LENGTH (the default).
+ *
+ * Build with: gcc -O2 train.c -o train -lm
+ */
+
+#include "wacky_train.c"
+
+int main(int argc, char** argv) {
+    int max_length = WACKY_MAX_DECODE_LENGTH;
+    int first = 1;
+    bool bad_length = false;
+    if (argc > 2 && strcmp(argv[1], "-l") == 0) {
+        // Longer codes would make a dictionary wacky_decoder_init() rejects.
+        char* end;
+        long length = strtol(argv[2], &end, 10);
+        bad_length = end == argv[2] || *end != '\0' || length < 1 ||
+                     length > WACKY_MAX_DECODE_LENGTH;
+        max_length = bad_length ? 0 : (int)length;
+        first = 3;
+    }
+    if (bad_length || argc - first < 2) {
+        printf("Usage: %s [-l max_length] dictionary sample...\n", argv[0]);
+        printf("max_length is 1 to %d bits.\n", WACKY_MAX_DECODE_LENGTH);
+        return 1;
+    }
+
+    WackyTrainer trainer;
+    wacky_trainer_init(&trainer);
+    for (int i = first + 1; i < argc; i++) {
+        if (!wacky_trainer_add_file(&trainer, argv[i])) {
+            printf("Could not read '%s'.\n", argv[i]);
+            return 1;
+        }
+    }
+
+    WackyCodeTable table;
+    if (!wacky_trainer_build_table(&trainer, max_length, true, &table)) {
+        printf("Could not fit 256 codes in %d bits.\n", max_length);
+        return 1;
+    }
+    if (!wacky_save_dictionary(argv[first], &table)) {
+        printf("Could not write '%s'.\n", argv[first]);
+        return 1;
+    }
+
+    uint64_t bits = count_encoded_bits(&table, trainer.counts);
+    printf("Trained on %llu bytes in %llu samples.\n",
+           (unsigned long long)trainer.byte_count,
+           (unsigned long long)trainer.sample_count);
+    printf("Samples would code at %.3f bits per byte, longest code %d bits.\n",
+           trainer.byte_count > 0 ? (double)bits / trainer.byte_count : 0.0,
+           table.max_length);
+    return 0;
+}
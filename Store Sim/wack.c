@@ -0,0 +1,201 @@
+/**
+ * Compresses and decompresses files.
+ *
+ * Usage: ./wack c input output
+ *        ./wack d input output
+ *
+ * Files are coded as containers (see wacky_container.c). The input is mapped
+ * into memory and never copied: it is histogrammed in place, the exact size of
+ * the result is computed up front, and the output file is sized and mapped so
+ * the encoder and decoder write straight into it. The time taken and the
+ * throughput are reported when done. Built with -DWACKY_STATS, it also prints
+ * the time spent in each stage (see wacky_stats.c).
+ *
+ * Build with: gcc -O2 wack.c -o wack -lm
+ */
+
+// madvise() and MADV_SEQUENTIAL are not part of ISO C.
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "wacky_container.c"
+
+/**
+ * Maps a whole file read-only. An empty file maps to NULL with `size` 0.
+ *
+ * @return false if the file cannot be opened or mapped. The file is the
+ * user's input, so it is left as it was either way; only map_output() removes
+ * a file, and only the one it created.
+ */
+bool map_input(const char* path, const uint8_t** data, size_t* size) {
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    *size = info.st_size;
+    *data = NULL;
+    if (*size > 0) {
+        void* mapping = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        madvise(mapping, *size, MADV_SEQUENTIAL);
+        *data = mapping;
+    }
+    close(fd);
+    return true;
+}
+
+/**
+ * Creates `path` with exactly `size` bytes and maps it for writing. A size of
+ * 0 creates an empty file and maps to NULL.
+ *
+ * @return false if the file cannot be created, sized or mapped, in which
+ * case no file is left behind.
+ */
+bool map_output(const char* path, size_t size, uint8_t** data) {
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    *data = NULL;
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        unlink(path);
+        return false;
+    }
+    if (size > 0) {
+        void* mapping =
+            mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            unlink(path);
+            return false;
+        }
+        *data = mapping;
+    }
+    close(fd);
+    return true;
+}
+
+void unmap(const uint8_t* data, size_t size) {
+    if (data != NULL) {
+        munmap((void*)data, size);
+    }
+}
+
+bool compress_file(const uint8_t* in, size_t in_size, const char* path,
+                   size_t* out_size) {
+    WackyCodeTable table = {.max_length = 0};
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    compute_byte_histogram(counts, in, in_size);
+    if (in_size > 0 &&
+        !build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH, &table)) {
+        return false;
+    }
+
+    *out_size = wacky_container_size(&table, counts);
+    uint8_t* out;
+    if (*out_size == 0 || !map_output(path, *out_size, &out)) {
+        return false;
+    }
+    size_t written = write_wacky_container(&table, in, in_size, out, *out_size);
+    unmap(out, *out_size);
+    if (written != *out_size) {
+        unlink(path);
+        return false;
+    }
+    return true;
+}
+
+bool decompress_file(const uint8_t* in, size_t in_size, const char* path,
+                     size_t* out_size) {
+    WackyContainer container;
+    if (!read_wacky_container(in, in_size, &container) ||
+        container.symbol_count > SIZE_MAX) {
+        return false;
+    }
+    *out_size = container.symbol_count;
+
+    WackyDecodeTable table;
+    if (*out_size > 0 && !build_wacky_decode_table(&container.codes, &table)) {
+        return false;
+    }
+    uint8_t* out = NULL;
+    bool created = map_output(path, *out_size, &out);
+    bool ok = created;
+    if (*out_size > 0) {
+        ok = ok && decode_bytes_with_table(&table, container.payload,
+                                           container.payload_size, out,
+                                           *out_size);
+        free_wacky_decode_table(&table);
+    }
+    unmap(out, *out_size);
+    // Leave no half-decoded file behind.
+    if (created && !ok) {
+        unlink(path);
+    }
+    return ok;
+}
+
+void print_stats() {
+    WackyStats stats;
+    wacky_get_stats(&stats);
+    for (int i = 0; i < WACKY_STAGE_COUNT; i++) {
+        if (stats.stage_calls[i] > 0) {
+            printf("  %-12s %14llu cycles\n", wacky_stage_name(i),
+                   (unsigned long long)stats.stage_cycles[i]);
+        }
+    }
+    if (stats.symbols_encoded > 0) {
+        printf("  %.3f bits per byte, entropy %.3f, longest code %d bits\n",
+               stats.average_code_length, stats.entropy, stats.max_code_length);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4 || (strcmp(argv[1], "c") != 0 && strcmp(argv[1], "d") != 0)) {
+        printf("Usage: %s c|d input output\n", argv[0]);
+        return 1;
+    }
+    bool compress = argv[1][0] == 'c';
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    const uint8_t* in;
+    size_t in_size, out_size = 0;
+    if (!map_input(argv[2], &in, &in_size)) {
+        printf("Could not read '%s'.\n", argv[2]);
+        return 1;
+    }
+    bool ok = compress ? compress_file(in, in_size, argv[3], &out_size)
+                       : decompress_file(in, in_size, argv[3], &out_size);
+    unmap(in, in_size);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (!ok) {
+        printf("Could not %s '%s' into '%s'.\n",
+               compress ? "compress" : "decompress", argv[2], argv[3]);
+        return 1;
+    }
+
+    double seconds =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    size_t plain_size = compress ? in_size : out_size;
+    printf("%zu -> %zu bytes (%.2f%%) in %.3f s, %.2f MB/s\n", in_size,
+           out_size, in_size > 0 ? 100.0 * out_size / in_size : 0.0, seconds,
+           seconds > 0 ? plain_size / seconds / 1e6 : 0.0);
+    if (wacky_stats_enabled()) {
+        print_stats();
+    }
+    return 0;
+}
@@ -1,4 +1,7 @@
 
+#ifndef WACKMAN_C
+#define WACKMAN_C
+
 #include "wackman.h"
 
 
@@ -27,12 +30,31 @@ void compute_occurrence_array(int occurrence_array[ASCII_CHARACTER_SET_SIZE], ch
         return;
     }
     while(*p != '\0'){
-        occurrence_array[*p] +=1; 
+        // Bytes above 127 have no slot in an ASCII occurrence array.
+        if((unsigned char)*p < ASCII_CHARACTER_SET_SIZE){
+            occurrence_array[(unsigned char)*p] +=1; 
+        }
         p++; 
     }
 }
 
 
+void compute_byte_occurrence_array(int occurrence_array[WACKY_BYTE_ALPHABET_SIZE], const unsigned char* data, size_t length) {
+    if(occurrence_array == NULL){
+        return;
+    }
+    for (int i =0; i < WACKY_BYTE_ALPHABET_SIZE; i++){
+        occurrence_array[i] = 0; 
+    } 
+    if(data == NULL){
+        return;
+    }
+    for (size_t i =0; i < length; i++){
+        occurrence_array[data[i]] +=1; 
+    }
+}
+
+
 int count_positive_occurrences(int occurrence_array[ASCII_CHARACTER_SET_SIZE]) {
     int sum =0;
     if(occurrence_array == NULL){
@@ -45,7 +67,7 @@ int count_positive_occurrences(int occurrence_array[ASCII_CHARACTER_SET_SIZE]) {
     return sum;
 }
 
-WackyLinkedNode* create_wacky_list(int occurrence_array[ASCII_CHARACTER_SET_SIZE]) {
+WackyLinkedNode* create_wacky_list_in(WackyArena* arena, int occurrence_array[ASCII_CHARACTER_SET_SIZE]) {
     WackyLinkedNode* head = NULL;
     WackyTreeNode* val = NULL;
     int arr_sum = sum_array_elements(occurrence_array, ASCII_CHARACTER_SET_SIZE);
@@ -57,18 +79,24 @@ WackyLinkedNode* create_wacky_list(int occurrence_array[ASCII_CHARACTER_SET_SIZE
             double weight = (double)occurrence_array[i] / arr_sum;
 
             char curr_val = occurrence_array[i];
-            val = new_leaf_node(weight, i);
-
-            WackyLinkedNode* linked_node = new_linked_node(val);
+            uint64_t count = occurrence_array[i];
+            val = arena_leaf_node(arena, count, weight, i);
+
+            WackyLinkedNode* linked_node = val == NULL ? NULL : arena_linked_node(arena, val);
+            if(linked_node == NULL){
+                discard_wacky_trees(arena, &val, 1);
+                discard_wacky_list(arena, head);
+                return NULL;
+            }
 
-            if(head == NULL || weight < head -> val -> weight || (weight == head -> val-> weight && i < head -> val -> val)){
+            if(head == NULL || count < head -> val -> count || (count == head -> val-> count && i < head -> val -> val)){
                 linked_node-> next = head;
                 head = linked_node; 
             }
             else{
                  WackyLinkedNode* temp = NULL;
                  temp = head; 
-                while(temp -> next != NULL && ((weight == temp ->next -> val-> weight && i > temp -> next->val -> val) || temp -> next -> val -> weight < weight)){
+                while(temp -> next != NULL && ((count == temp ->next -> val-> count && i > temp -> next->val -> val) || temp -> next -> val -> count < count)){
                     temp = temp -> next; 
                 }
                 linked_node -> next = temp -> next;
@@ -81,7 +109,12 @@ WackyLinkedNode* create_wacky_list(int occurrence_array[ASCII_CHARACTER_SET_SIZE
 }
 
 
-WackyTreeNode* merge_wacky_list(WackyLinkedNode* linked_list) {
+WackyLinkedNode* create_wacky_list(int occurrence_array[ASCII_CHARACTER_SET_SIZE]) {
+    return create_wacky_list_in(NULL, occurrence_array);
+}
+
+
+WackyTreeNode* merge_wacky_list_in(WackyArena* arena, WackyLinkedNode* linked_list) {
     WackyLinkedNode* head = linked_list;
     WackyTreeNode* boobs = NULL; 
     if (head == NULL){
@@ -89,7 +122,7 @@ WackyTreeNode* merge_wacky_list(WackyLinkedNode* linked_list) {
     }
     if (head -> next == NULL){
         boobs = head->val; 
-        free(head);
+        release_linked_node(arena, head);
         return boobs; 
     }
     WackyLinkedNode *first = NULL, *second = NULL, *new_node = NULL; 
@@ -98,18 +131,28 @@ WackyTreeNode* merge_wacky_list(WackyLinkedNode* linked_list) {
         first = head;
         second = head->next; 
         head = head->next->next; 
-        new_branch = new_branch_node(first->val, second->val); 
-        new_node = new_linked_node(new_branch); 
-        free(first);
-        free(second);
-        if(head == NULL || new_node->val->weight < head ->val->weight|| new_node->val->weight == head -> val ->weight){
+        new_branch = arena_branch_node(arena, first->val, second->val); 
+        if(new_branch == NULL){
+            // first and second are still linked ahead of head.
+            discard_wacky_list(arena, first);
+            return NULL;
+        }
+        new_node = arena_linked_node(arena, new_branch); 
+        release_linked_node(arena, first);
+        release_linked_node(arena, second);
+        if(new_node == NULL){
+            discard_wacky_trees(arena, &new_branch, 1);
+            discard_wacky_list(arena, head);
+            return NULL;
+        }
+        if(head == NULL || compare_wacky_nodes(new_node->val, head->val) <= 0){
             new_node -> next = head;
             head = new_node; 
         }
         else{
             WackyLinkedNode* temp2 = NULL;
             temp2 = head;
-            while(temp2 ->next != NULL && temp2 -> next -> val -> weight < new_node->val->weight){
+            while(temp2 ->next != NULL && compare_wacky_nodes(temp2->next->val, new_node->val) < 0){
                 temp2 = temp2 ->next;
             }
             new_node -> next = temp2 -> next;
@@ -117,11 +160,16 @@ WackyTreeNode* merge_wacky_list(WackyLinkedNode* linked_list) {
         }
     }
     boobs = head->val;
-    free(head);
+    release_linked_node(arena, head);
     return boobs; 
 }
 
 
+WackyTreeNode* merge_wacky_list(WackyLinkedNode* linked_list) {
+    return merge_wacky_list_in(NULL, linked_list);
+}
+
+
 int get_height(WackyTreeNode* tree) {
     if (tree == NULL)
         return 0; 
@@ -187,4 +235,5 @@ void free_tree(WackyTreeNode* tree) {
     free_tree(tree->right);
     free(tree); 
 }
- 
\ No newline at end of file
+
+#endif
@@ -1,12 +1,19 @@
+#ifndef WACKMAN_H
+#define WACKMAN_H
+
 #include <limits.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "wacky_stats.c"
+
 #define TREE_SPACING 10
 #define ASCII_CHARACTER_SET_SIZE 128
+#define WACKY_BYTE_ALPHABET_SIZE 256
 
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
@@ -15,6 +22,13 @@ int setBit(int n, int k) { return (n | (1 << k)); }
 
 bool findBit(int n, int k) { return ((n >> k) & 1); }
 
+/**
+ * `count` is the exact number of occurrences under a node, so the same counts
+ * give the same tree on every machine. `weight` is the same thing as a
+ * fraction of the input, as in the original API. Both are kept, at 8 bytes a
+ * node: a double stops being exact past 2^53 occurrences, so `weight` cannot
+ * stand in for `count`, and nodes from new_leaf_node() have only a weight.
+ */
 typedef struct WackyTreeNode WackyTreeNode;
 struct WackyTreeNode {
     double weight;
@@ -22,6 +36,7 @@ struct WackyTreeNode {
 
     WackyTreeNode* left;
     WackyTreeNode* right;
+    uint64_t count;
 };
 
 typedef struct WackyLinkedNode WackyLinkedNode;
@@ -30,8 +45,21 @@ struct WackyLinkedNode {
     WackyLinkedNode* next;
 };
 
+/**
+ * Leaves are the only nodes without children. Branches also carry a '\0' val
+ * for compatibility, so a NUL leaf cannot be told apart by val alone.
+ */
+bool is_wacky_leaf(WackyTreeNode* node) {
+    return node->left == NULL && node->right == NULL;
+}
+
+/**
+ * Makes a leaf with a weight only; its count is 0, so lists of these are
+ * ordered by weight (see compare_wacky_nodes()).
+ */
 WackyTreeNode* new_leaf_node(double weight, char val) {
     WackyTreeNode* node = (WackyTreeNode*)malloc(sizeof(WackyTreeNode));
+    node->count = 0;
     node->weight = weight;
     node->val = val;
     node->left = NULL;
@@ -41,6 +69,7 @@ WackyTreeNode* new_leaf_node(double weight, char val) {
 
 WackyTreeNode* new_branch_node(WackyTreeNode* left, WackyTreeNode* right) {
     WackyTreeNode* node = (WackyTreeNode*)malloc(sizeof(WackyTreeNode));
+    node->count = left->count + right->count;
     node->weight = left->weight + right->weight;
     node->val = '\0';
     node->left = left;
@@ -48,9 +77,155 @@ WackyTreeNode* new_branch_node(WackyTreeNode* left, WackyTreeNode* right) {
     return node;
 }
 
+/**
+ * Orders two nodes by count, or by weight when neither has one. Nodes from
+ * the count builders always have a count of at least 1, so only counts decide
+ * between them; nodes from new_leaf_node() and their branches have a count of
+ * 0 and are ordered by weight, as before counts existed.
+ *
+ * @return Less than, equal to or greater than 0 as `a` comes before, with or
+ * after `b`.
+ */
+int compare_wacky_nodes(const WackyTreeNode* a, const WackyTreeNode* b) {
+    if (a->count == 0 && b->count == 0) {
+        return (a->weight > b->weight) - (a->weight < b->weight);
+    }
+    return (a->count > b->count) - (a->count < b->count);
+}
+
 WackyLinkedNode* new_linked_node(WackyTreeNode* val) {
     WackyLinkedNode* node = (WackyLinkedNode*)malloc(sizeof(WackyLinkedNode));
     node->val = val;
     node->next = NULL;
     return node;
 }
+
+/**
+ * A single block holding every node of one tree (at most 2n - 1 for n
+ * characters) plus the linked nodes used while building it. The whole tree is
+ * released with one free_wacky_arena() instead of free_tree().
+ */
+typedef struct WackyArena WackyArena;
+struct WackyArena {
+    WackyTreeNode* tree_nodes;
+    int tree_used;
+    int tree_capacity;
+
+    WackyLinkedNode* linked_nodes;
+    int linked_used;
+    int linked_capacity;
+};
+
+WackyArena* new_wacky_arena(int character_count) {
+    int capacity = MAX(2 * character_count - 1, 1);
+    WackyArena* arena = (WackyArena*)malloc(
+        sizeof(WackyArena) +
+        capacity * (sizeof(WackyTreeNode) + sizeof(WackyLinkedNode)));
+    if (arena == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    arena->tree_nodes = (WackyTreeNode*)(arena + 1);
+    arena->tree_used = 0;
+    arena->tree_capacity = capacity;
+    arena->linked_nodes = (WackyLinkedNode*)(arena->tree_nodes + capacity);
+    arena->linked_used = 0;
+    arena->linked_capacity = capacity;
+    return arena;
+}
+
+void free_wacky_arena(WackyArena* arena) { free(arena); }
+
+/**
+ * The arena versions of the constructors above. A NULL arena falls back to
+ * malloc, so the same construction code serves both modes. Each returns NULL
+ * when the arena is full or malloc fails.
+ */
+WackyTreeNode* arena_tree_node(WackyArena* arena) {
+    if (arena == NULL) {
+        WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+        return (WackyTreeNode*)malloc(sizeof(WackyTreeNode));
+    }
+    if (arena->tree_used == arena->tree_capacity) {
+        return NULL;
+    }
+    return &arena->tree_nodes[arena->tree_used++];
+}
+
+WackyTreeNode* arena_leaf_node(WackyArena* arena, uint64_t count,
+                               double weight, char val) {
+    WackyTreeNode* node = arena_tree_node(arena);
+    if (node == NULL) {
+        return NULL;
+    }
+    node->count = count;
+    node->weight = weight;
+    node->val = val;
+    node->left = NULL;
+    node->right = NULL;
+    return node;
+}
+
+WackyTreeNode* arena_branch_node(WackyArena* arena, WackyTreeNode* left,
+                                 WackyTreeNode* right) {
+    WackyTreeNode* node = arena_tree_node(arena);
+    if (node == NULL) {
+        return NULL;
+    }
+    node->count = left->count + right->count;
+    node->weight = left->weight + right->weight;
+    node->val = '\0';
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+WackyLinkedNode* arena_linked_node(WackyArena* arena, WackyTreeNode* val) {
+    WackyLinkedNode* node;
+    if (arena == NULL) {
+        WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+        node = (WackyLinkedNode*)malloc(sizeof(WackyLinkedNode));
+        if (node == NULL) {
+            return NULL;
+        }
+    } else if (arena->linked_used < arena->linked_capacity) {
+        node = &arena->linked_nodes[arena->linked_used++];
+    } else {
+        return NULL;
+    }
+    node->val = val;
+    node->next = NULL;
+    return node;
+}
+
+void release_linked_node(WackyArena* arena, WackyLinkedNode* node) {
+    if (arena == NULL) {
+        free(node);
+    }
+}
+
+void free_tree(WackyTreeNode* tree);
+
+/**
+ * Cleanup for a build that ran out of nodes partway. Frees the given trees,
+ * or the list and the trees it holds, when they were malloc'd; arena nodes
+ * are left to go with the arena.
+ */
+void discard_wacky_trees(WackyArena* arena, WackyTreeNode* trees[], int count) {
+    if (arena == NULL) {
+        for (int i = 0; i < count; i++) {
+            free_tree(trees[i]);
+        }
+    }
+}
+
+void discard_wacky_list(WackyArena* arena, WackyLinkedNode* list) {
+    while (arena == NULL && list != NULL) {
+        WackyLinkedNode* next = list->next;
+        free_tree(list->val);
+        free(list);
+        list = next;
+    }
+}
+
+#endif
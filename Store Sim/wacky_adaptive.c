@@ -0,0 +1,247 @@
+#ifndef WACKY_ADAPTIVE_C
+#define WACKY_ADAPTIVE_C
+
+#include "wacky_limit.c"
+#include "wacky_stream.c"
+
+/**
+ * Adaptive coding: a single pass over the input, with no histogram up front.
+ * Encoder and decoder both start from the same model, in which every byte
+ * has been seen once, and code each symbol with the current tree. After
+ * every symbol they count it, and every so often they rebuild the tree from
+ * the counts through build_wacky_tree_from_counts(). Since both sides see the
+ * same symbols in the same order, they rebuild the same tree at the same
+ * point and never exchange it.
+ *
+ * Rebuilds come after WACKY_ADAPTIVE_FIRST_INTERVAL symbols, and the interval
+ * doubles after each one up to WACKY_ADAPTIVE_MAX_INTERVAL, so the model
+ * settles quickly and later rebuilds stay cheap. Once the counts add up to
+ * more than WACKY_ADAPTIVE_MAX_TOTAL they are halved, keeping every count at
+ * least 1, so the model keeps following input whose statistics drift.
+ *
+ * The output is a framed stream like those of wacky_stream.c, and is coded
+ * by the same wacky_frame_encode() and wacky_frame_decode() steps, one call
+ * for each run of symbols between two rebuilds. The decoder therefore needs
+ * no symbol count, and the encoder can be flushed.
+ */
+
+#define WACKY_ADAPTIVE_FIRST_INTERVAL 256
+#define WACKY_ADAPTIVE_MAX_INTERVAL 16384
+#define WACKY_ADAPTIVE_MAX_TOTAL ((uint64_t)1 << 20)
+
+typedef struct WackyAdaptiveModel WackyAdaptiveModel;
+struct WackyAdaptiveModel {
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE];
+    uint64_t total;
+    uint64_t interval;
+    // Symbols left to code before the next rebuild.
+    uint64_t until_rebuild;
+    WackyCodeTable codes;
+};
+
+typedef struct WackyAdaptiveEncoder WackyAdaptiveEncoder;
+struct WackyAdaptiveEncoder {
+    WackyAdaptiveModel model;
+    WackyFrameWriter frames;
+    uint64_t symbol_count;
+    uint64_t bytes_written;
+};
+
+typedef struct WackyAdaptiveDecoder WackyAdaptiveDecoder;
+struct WackyAdaptiveDecoder {
+    WackyAdaptiveModel model;
+    WackyDecodeTable table;
+    WackyFrameReader frames;
+};
+
+/**
+ * Rebuilds the code table from the counts and schedules the next rebuild.
+ *
+ * @return false if memory runs out.
+ */
+bool rebuild_adaptive_model(WackyAdaptiveModel* model) {
+    if (model->total > WACKY_ADAPTIVE_MAX_TOTAL) {
+        model->total = 0;
+        for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+            model->counts[i] = (model->counts[i] + 1) / 2;
+            model->total += model->counts[i];
+        }
+    }
+    // All 256 bytes always have a code, and any 256 counts fit in
+    // WACKY_MAX_DECODE_LENGTH bits, so only a failed allocation can fail.
+    if (!build_canonical_byte_table(model->counts, WACKY_MAX_DECODE_LENGTH,
+                                    &model->codes)) {
+        return false;
+    }
+    model->until_rebuild = model->interval;
+    model->interval = MIN(model->interval * 2, WACKY_ADAPTIVE_MAX_INTERVAL);
+    return true;
+}
+
+bool init_adaptive_model(WackyAdaptiveModel* model) {
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        model->counts[i] = 1;
+    }
+    model->total = WACKY_BYTE_ALPHABET_SIZE;
+    model->interval = WACKY_ADAPTIVE_FIRST_INTERVAL;
+    return rebuild_adaptive_model(model);
+}
+
+/**
+ * Counts a run of coded symbols, which must not go past the next rebuild.
+ *
+ * @return true if the model is now due for a rebuild.
+ */
+static inline bool update_adaptive_model(WackyAdaptiveModel* model,
+                                         const uint8_t* symbols, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        model->counts[symbols[i]]++;
+    }
+    model->total += count;
+    model->until_rebuild -= count;
+    return model->until_rebuild == 0;
+}
+
+/**
+ * @return false if memory runs out.
+ */
+bool wacky_adaptive_encoder_init(WackyAdaptiveEncoder* encoder) {
+    frame_writer_init(&encoder->frames);
+    encoder->symbol_count = 0;
+    encoder->bytes_written = 0;
+    return init_adaptive_model(&encoder->model);
+}
+
+/**
+ * Encodes as much of `in` as fits in `out`, updating the model as it goes.
+ * Works like wacky_stream_encode(), except that every byte has a code.
+ *
+ * @return WACKY_STREAM_OK once all of `in` is consumed,
+ * WACKY_STREAM_OUTPUT_FULL if `out` ran out first, or WACKY_STREAM_ERROR if
+ * a rebuild runs out of memory.
+ */
+WackyStreamStatus wacky_adaptive_encode(WackyAdaptiveEncoder* encoder,
+                                        const uint8_t* in, size_t in_size,
+                                        size_t* in_consumed, uint8_t* out,
+                                        size_t out_capacity,
+                                        size_t* out_written) {
+    WackyAdaptiveModel* model = &encoder->model;
+    frame_writer_set_output(&encoder->frames, out, out_capacity);
+    WackyStreamStatus status = WACKY_STREAM_OK;
+    size_t i = 0;
+
+    while (i < in_size && status == WACKY_STREAM_OK) {
+        size_t run = (size_t)MIN((uint64_t)(in_size - i), model->until_rebuild);
+        size_t taken = wacky_frame_encode(&encoder->frames, &model->codes,
+                                          &in[i], run, &status);
+        // Symbols already taken count as consumed even if the rebuild fails.
+        if (update_adaptive_model(model, &in[i], taken) &&
+            !rebuild_adaptive_model(model)) {
+            status = WACKY_STREAM_ERROR;
+        }
+        i += taken;
+    }
+
+    *in_consumed = i;
+    *out_written = encoder->frames.out - out;
+    encoder->symbol_count += i;
+    encoder->bytes_written += *out_written;
+    return status;
+}
+
+/**
+ * Writes out everything encoded so far, like wacky_stream_encoder_flush().
+ */
+WackyStreamStatus wacky_adaptive_encoder_flush(WackyAdaptiveEncoder* encoder,
+                                               uint8_t* out,
+                                               size_t out_capacity,
+                                               size_t* out_written) {
+    frame_writer_set_output(&encoder->frames, out, out_capacity);
+    WackyStreamStatus status = wacky_frame_flush(&encoder->frames);
+    *out_written = encoder->frames.out - out;
+    encoder->bytes_written += *out_written;
+    return status;
+}
+
+/**
+ * Flushes the encoder and ends the stream, like
+ * wacky_stream_encoder_finish().
+ */
+WackyStreamStatus wacky_adaptive_encoder_finish(WackyAdaptiveEncoder* encoder,
+                                                uint8_t* out,
+                                                size_t out_capacity,
+                                                size_t* out_written) {
+    frame_writer_set_output(&encoder->frames, out, out_capacity);
+    WackyStreamStatus status = wacky_frame_finish(&encoder->frames);
+    *out_written = encoder->frames.out - out;
+    encoder->bytes_written += *out_written;
+    return status;
+}
+
+/**
+ * Rebuilds the decoder's model and its decode table in step with the
+ * encoder.
+ */
+bool rebuild_adaptive_decoder(WackyAdaptiveDecoder* decoder) {
+    free_wacky_decode_table(&decoder->table);
+    return rebuild_adaptive_model(&decoder->model) &&
+           build_wacky_decode_table(&decoder->model.codes, &decoder->table);
+}
+
+/**
+ * @param decoder The context to set up. Release it with
+ * wacky_adaptive_decoder_free().
+ *
+ * @return false if memory runs out.
+ */
+bool wacky_adaptive_decoder_init(WackyAdaptiveDecoder* decoder) {
+    decoder->table.entries = NULL;
+    decoder->table.entry_count = 0;
+    frame_reader_init(&decoder->frames);
+    return init_adaptive_model(&decoder->model) &&
+           build_wacky_decode_table(&decoder->model.codes, &decoder->table);
+}
+
+void wacky_adaptive_decoder_free(WackyAdaptiveDecoder* decoder) {
+    free_wacky_decode_table(&decoder->table);
+}
+
+/**
+ * Decodes as many symbols as the input and output space allow, updating the
+ * model as it goes. Works like wacky_stream_decode(), and returns the same
+ * statuses; running out of memory in a rebuild is an error as well.
+ */
+WackyStreamStatus wacky_adaptive_decode(WackyAdaptiveDecoder* decoder,
+                                        const uint8_t* in, size_t in_size,
+                                        size_t* in_consumed, uint8_t* out,
+                                        size_t out_capacity,
+                                        size_t* out_written) {
+    WackyAdaptiveModel* model = &decoder->model;
+    size_t position = 0;
+    size_t produced = 0;
+    WackyStreamStatus status = WACKY_STREAM_OUTPUT_FULL;
+
+    // Stopping at every rebuild keeps a pair entry from decoding its second
+    // symbol with the table that is about to be replaced.
+    while (status == WACKY_STREAM_OUTPUT_FULL && produced < out_capacity) {
+        size_t run = (size_t)MIN((uint64_t)(out_capacity - produced),
+                                 model->until_rebuild);
+        size_t consumed;
+        size_t written;
+        status = wacky_frame_decode(&decoder->frames, &decoder->table,
+                                    &in[position], in_size - position,
+                                    &consumed, &out[produced], run, &written);
+        position += consumed;
+        if (update_adaptive_model(model, &out[produced], written) &&
+            !rebuild_adaptive_decoder(decoder)) {
+            status = WACKY_STREAM_ERROR;
+        }
+        produced += written;
+    }
+
+    *in_consumed = position;
+    *out_written = produced;
+    return status;
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef WACKY_BATCH_C
+#define WACKY_BATCH_C
+
+#include "wacky_context.c"
+
+/**
+ * Batches: many short records coded against one shared code in a single
+ * call. A batch has one header and one bit stream for all of its records:
+ *
+ *   varint      the number of records N
+ *   varints     the length of each record, in order (the record table)
+ *   bit stream  the codes of every record back to back, see
+ *               encode_bytes_to_stream()
+ *
+ * Varints are those of wacky_context.c. A record's place in the decoded
+ * output follows from the lengths before it, so the record table is all the
+ * decoder needs to split the output again. Since records share the stream,
+ * there is one bit writer, one final padding and one bit reader per batch
+ * rather than per record, and nothing is allocated per record. The price is
+ * that a single record can no longer be decoded on its own; code it as a
+ * message (wacky_encode_message()) if it must be.
+ */
+
+typedef struct WackyRecord WackyRecord;
+struct WackyRecord {
+    const uint8_t* data;
+    size_t length;
+};
+
+/**
+ * Returns the most bytes wacky_encode_batch() can write for `records`.
+ */
+size_t wacky_batch_bound(WackyEncoderContext* context,
+                         const WackyRecord* records, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += records[i].length;
+    }
+    return (count + 1) * WACKY_MAX_VARINT_SIZE +
+           (total * (size_t)context->codes.max_length + CHAR_BIT - 1) /
+               CHAR_BIT;
+}
+
+/**
+ * Encodes every record into one batch.
+ *
+ * @param context An encoder set up by wacky_encoder_init().
+ * @param records The records to encode.
+ * @param count The number of records.
+ * @param out Where to write the batch.
+ * @param capacity The size of `out`; wacky_batch_bound() is always enough.
+ *
+ * @return The size of the batch, or 0 if a byte has no code or `out` is too
+ * small.
+ */
+size_t wacky_encode_batch(WackyEncoderContext* context,
+                          const WackyRecord* records, size_t count,
+                          uint8_t* out, size_t capacity) {
+    if (context == NULL || (records == NULL && count > 0) || out == NULL) {
+        return 0;
+    }
+    size_t position = write_wacky_varint(count, out, capacity);
+    for (size_t i = 0; position > 0 && i < count; i++) {
+        size_t size = write_wacky_varint(records[i].length, &out[position],
+                                         capacity - position);
+        position = size > 0 ? position + size : 0;
+    }
+    if (position == 0) {
+        return 0;
+    }
+
+    WACKY_STAGE_BEGIN(WACKY_STAGE_ENCODE);
+    WackyBitWriter writer;
+    bit_writer_init(&writer, &out[position], capacity - position);
+    for (size_t i = 0; i < count; i++) {
+        if (!bit_writer_put_bytes(&writer, &context->codes, records[i].data,
+                                  records[i].length)) {
+            return 0;
+        }
+    }
+    if (!bit_writer_finish(&writer)) {
+        return 0;
+    }
+    WACKY_STAGE_END(WACKY_STAGE_ENCODE);
+    return writer.out - out;
+}
+
+/**
+ * wacky_encode_batch() into a new buffer, allocated once for the batch.
+ *
+ * @param out_size Set to the size of the batch.
+ *
+ * @return The batch, which the caller must free, or NULL if a byte has no
+ * code or memory runs out.
+ */
+uint8_t* wacky_compress_batch(WackyEncoderContext* context,
+                              const WackyRecord* records, size_t count,
+                              size_t* out_size) {
+    if (context == NULL || (records == NULL && count > 0) || out_size == NULL) {
+        return NULL;
+    }
+    size_t capacity = wacky_batch_bound(context, records, count);
+    uint8_t* out = malloc(capacity);
+    if (out == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    *out_size = wacky_encode_batch(context, records, count, out, capacity);
+    if (*out_size == 0) {
+        free(out);
+        return NULL;
+    }
+    return out;
+}
+
+/**
+ * Reads the header of a batch, so the caller can size the buffers for
+ * wacky_decode_batch().
+ *
+ * @param count Set to the number of records.
+ * @param total_length Set to the number of bytes they decode to.
+ *
+ * @return false if the header is truncated or its lengths overflow.
+ */
+bool wacky_read_batch_size(const uint8_t* in, size_t size, size_t* count,
+                           size_t* total_length) {
+    uint64_t value;
+    size_t position;
+    // Every record takes at least one byte of the record table.
+    if (in == NULL || count == NULL || total_length == NULL ||
+        (position = read_wacky_varint(in, size, &value)) == 0 ||
+        value > size) {
+        return false;
+    }
+    *count = value;
+    *total_length = 0;
+    for (size_t i = 0; i < *count; i++) {
+        size_t read = read_wacky_varint(&in[position], size - position, &value);
+        if (read == 0 || value > SIZE_MAX - *total_length) {
+            return false;
+        }
+        position += read;
+        *total_length += value;
+    }
+    return true;
+}
+
+/**
+ * Decodes every record of a batch into one buffer, back to back.
+ *
+ * @param context A decoder for the codes the batch was encoded with.
+ * @param in The batch.
+ * @param size The number of bytes at `in`.
+ * @param out Where to write the decoded records.
+ * @param capacity The size of `out`.
+ * @param records Filled with where each decoded record is in `out`.
+ * @param max_records The number of entries at `records`.
+ * @param count Set to the number of records.
+ *
+ * @return false if the batch is corrupt or `out` or `records` is too small;
+ * wacky_read_batch_size() gives the sizes needed.
+ */
+bool wacky_decode_batch(WackyDecoderContext* context, const uint8_t* in,
+                        size_t size, uint8_t* out, size_t capacity,
+                        WackyRecord* records, size_t max_records,
+                        size_t* count) {
+    uint64_t value;
+    size_t position;
+    if (context == NULL || in == NULL || (records == NULL && max_records > 0) ||
+        count == NULL ||
+        (position = read_wacky_varint(in, size, &value)) == 0 ||
+        value > max_records) {
+        return false;
+    }
+    *count = value;
+    size_t total = 0;
+    for (size_t i = 0; i < *count; i++) {
+        size_t read = read_wacky_varint(&in[position], size - position, &value);
+        if (read == 0 || value > capacity - total) {
+            return false;
+        }
+        position += read;
+        records[i].data = &out[total];
+        records[i].length = value;
+        total += value;
+    }
+    return decode_bytes_with_table(&context->table, &in[position],
+                                   size - position, out, total);
+}
+
+#endif
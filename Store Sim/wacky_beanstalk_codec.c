@@ -0,0 +1,455 @@
+/**
+ * Static codec "wacky_beanstalk", generated by write_static_codec() in
+ * wacky_generate.c. Do not edit; regenerate it instead.
+ *
+ * Generated by: ./gen beanstalk wacky_beanstalk wacky_beanstalk_codec.c
+ *
+ * Longest code 12 bits, 2262 decode slots.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static const uint32_t wacky_beanstalk_code_bits[256] = {
+    0x0000054fu, 0x00000d4fu, 0x0000034fu, 0x00000b4fu, 0x0000074fu, 0x00000f4fu, 0x000000cfu, 0x000008cfu,
+    0x000004cfu, 0x00000ccfu, 0x000002cfu, 0x00000acfu, 0x000006cfu, 0x00000ecfu, 0x000001cfu, 0x000009cfu,
+    0x000005cfu, 0x00000dcfu, 0x000003cfu, 0x00000bcfu, 0x000007cfu, 0x00000fcfu, 0x0000002fu, 0x0000082fu,
+    0x0000042fu, 0x00000c2fu, 0x0000022fu, 0x00000a2fu, 0x0000062fu, 0x00000e2fu, 0x0000012fu, 0x0000092fu,
+    0x00000000u, 0x00000037u, 0x0000052fu, 0x00000d2fu, 0x0000032fu, 0x00000b2fu, 0x0000072fu, 0x00000f2fu,
+    0x000000afu, 0x000008afu, 0x000004afu, 0x00000cafu, 0x00000003u, 0x000000b7u, 0x00000023u, 0x000002afu,
+    0x00000aafu, 0x000006afu, 0x00000eafu, 0x000001afu, 0x000009afu, 0x000005afu, 0x00000dafu, 0x000003afu,
+    0x00000bafu, 0x000007afu, 0x00000fafu, 0x0000006fu, 0x0000086fu, 0x0000046fu, 0x00000c6fu, 0x0000026fu,
+    0x00000a6fu, 0x0000008fu, 0x000000f7u, 0x0000066fu, 0x00000e6fu, 0x0000028fu, 0x000001f7u, 0x0000016fu,
+    0x0000000fu, 0x0000010fu, 0x00000027u, 0x0000096fu, 0x0000056fu, 0x00000d6fu, 0x0000036fu, 0x0000018fu,
+    0x00000b6fu, 0x0000076fu, 0x00000f6fu, 0x0000004fu, 0x00000077u, 0x000000efu, 0x000008efu, 0x0000038fu,
+    0x000004efu, 0x00000cefu, 0x000002efu, 0x00000aefu, 0x000006efu, 0x00000eefu, 0x000001efu, 0x000009efu,
+    0x000005efu, 0x00000002u, 0x00000013u, 0x00000033u, 0x00000009u, 0x00000004u, 0x0000000bu, 0x00000019u,
+    0x0000000au, 0x00000006u, 0x00000defu, 0x0000002bu, 0x00000005u, 0x0000001bu, 0x0000000eu, 0x00000015u,
+    0x00000067u, 0x000003efu, 0x0000000du, 0x0000001du, 0x00000001u, 0x0000003bu, 0x00000017u, 0x00000007u,
+    0x00000befu, 0x00000057u, 0x000007efu, 0x00000fefu, 0x0000001fu, 0x0000081fu, 0x0000041fu, 0x00000c1fu,
+    0x0000021fu, 0x00000a1fu, 0x0000061fu, 0x00000e1fu, 0x0000011fu, 0x0000091fu, 0x0000051fu, 0x00000d1fu,
+    0x0000031fu, 0x00000b1fu, 0x0000071fu, 0x00000f1fu, 0x0000009fu, 0x0000089fu, 0x0000049fu, 0x00000c9fu,
+    0x0000029fu, 0x00000a9fu, 0x0000069fu, 0x00000e9fu, 0x0000019fu, 0x0000099fu, 0x0000059fu, 0x00000d9fu,
+    0x0000039fu, 0x00000b9fu, 0x0000079fu, 0x00000f9fu, 0x0000005fu, 0x0000085fu, 0x0000045fu, 0x00000c5fu,
+    0x0000025fu, 0x00000a5fu, 0x0000065fu, 0x00000e5fu, 0x0000015fu, 0x0000095fu, 0x0000055fu, 0x00000d5fu,
+    0x0000035fu, 0x00000b5fu, 0x0000075fu, 0x00000f5fu, 0x000000dfu, 0x000008dfu, 0x000004dfu, 0x00000cdfu,
+    0x000002dfu, 0x00000adfu, 0x000006dfu, 0x00000edfu, 0x000001dfu, 0x000009dfu, 0x000005dfu, 0x00000ddfu,
+    0x000003dfu, 0x00000bdfu, 0x000007dfu, 0x00000fdfu, 0x0000003fu, 0x0000083fu, 0x0000043fu, 0x00000c3fu,
+    0x0000023fu, 0x00000a3fu, 0x0000063fu, 0x00000e3fu, 0x0000013fu, 0x0000093fu, 0x0000053fu, 0x00000d3fu,
+    0x0000033fu, 0x00000b3fu, 0x0000073fu, 0x00000f3fu, 0x000000bfu, 0x000008bfu, 0x000004bfu, 0x00000cbfu,
+    0x000002bfu, 0x00000abfu, 0x000006bfu, 0x00000ebfu, 0x000001bfu, 0x000009bfu, 0x000005bfu, 0x00000dbfu,
+    0x000003bfu, 0x00000bbfu, 0x000007bfu, 0x00000fbfu, 0x0000007fu, 0x0000087fu, 0x0000047fu, 0x00000c7fu,
+    0x0000027fu, 0x00000a7fu, 0x0000067fu, 0x00000e7fu, 0x0000017fu, 0x0000097fu, 0x0000057fu, 0x00000d7fu,
+    0x0000037fu, 0x00000b7fu, 0x0000077fu, 0x00000f7fu, 0x000000ffu, 0x000008ffu, 0x000004ffu, 0x00000cffu,
+    0x000002ffu, 0x00000affu, 0x000006ffu, 0x00000effu, 0x000001ffu, 0x000009ffu, 0x000005ffu, 0x00000dffu,
+    0x000003ffu, 0x00000bffu, 0x000007ffu, 0x00000fffu, 0x0000044fu, 0x0000024fu, 0x0000064fu, 0x0000014fu,
+};
+
+static const uint8_t wacky_beanstalk_code_lengths[256] = {
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+      3,   8,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,   6,   8,   6,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  10,   9,  12,  12,  10,   9,  12,
+      9,   9,   7,  12,  12,  12,  12,  10,
+     12,  12,  12,  11,   8,  12,  12,  10,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,   4,   6,   6,   5,   3,   6,   5,
+      4,   4,  12,   6,   5,   6,   4,   5,
+      7,  12,   5,   5,   4,   6,   7,   6,
+     12,   7,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  11,  11,  11,  11,
+};
+
+static const uint32_t wacky_beanstalk_decode_slots[2262] = {
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6246202cu, 0x61832065u, 0x6205206cu, 0x61c42069u, 0x62462077u,
+    0x61c37420u, 0x62052064u, 0x61c42068u, 0x62462066u, 0x61c37465u, 0x62052072u, 0x61c4206eu, 0x52490048u,
+    0x61c36120u, 0x62047474u, 0x62047461u, 0x62462062u, 0x61c36165u, 0x6205206fu, 0x62047469u, 0x62872076u,
+    0x62432c20u, 0x62052067u, 0x62047468u, 0x6246206du, 0x62432c65u, 0x62052073u, 0x6204746eu, 0x82c40856u,
+    0x61836520u, 0x62046174u, 0x62046161u, 0x6246202eu, 0x61836565u, 0x6245746cu, 0x62046169u, 0x6287204au,
+    0x62036c20u, 0x62457464u, 0x62046168u, 0x6246206bu, 0x62036c65u, 0x62457472u, 0x6204616eu, 0x82c40816u,
+    0x61c36920u, 0x62842c74u, 0x62842c61u, 0x62462063u, 0x61c36965u, 0x6245746fu, 0x62842c69u, 0x62c82021u,
+    0x62437720u, 0x62457467u, 0x62842c68u, 0x62462075u, 0x62437765u, 0x62457473u, 0x62842c6eu, 0x82c40896u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x6286742cu, 0x61832065u, 0x6245616cu, 0x61c46569u, 0x62867477u,
+    0x62036420u, 0x62456164u, 0x61c46568u, 0x62867466u, 0x62036465u, 0x62456172u, 0x61c4656eu, 0x52cb0053u,
+    0x61c36820u, 0x62446c74u, 0x62446c61u, 0x62867462u, 0x61c36865u, 0x6245616fu, 0x62446c69u, 0x62872079u,
+    0x62436620u, 0x62456167u, 0x62446c68u, 0x6286746du, 0x62436665u, 0x62456173u, 0x62446c6eu, 0x82c40876u,
+    0x61836520u, 0x62046974u, 0x62046961u, 0x6286742eu, 0x61836565u, 0x62c52c6cu, 0x62046969u, 0x62872070u,
+    0x62037220u, 0x62c52c64u, 0x62046968u, 0x6286746bu, 0x62037265u, 0x62c52c72u, 0x6204696eu, 0x82c40836u,
+    0x61c36e20u, 0x62847774u, 0x62847761u, 0x62867463u, 0x61c36e65u, 0x62c52c6fu, 0x62847769u, 0x62c82054u,
+    0x50c30020u, 0x62c52c67u, 0x62847768u, 0x62867475u, 0x50c30065u, 0x62c52c73u, 0x6284776eu, 0x82c408b6u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6286612cu, 0x61832065u, 0x6205656cu, 0x61c42069u, 0x62866177u,
+    0x61c37420u, 0x62056564u, 0x61c42068u, 0x62866166u, 0x61c37465u, 0x62056572u, 0x61c4206eu, 0x528a0041u,
+    0x61c36120u, 0x62446474u, 0x62446461u, 0x62866162u, 0x61c36165u, 0x6205656fu, 0x62446469u, 0x62c77476u,
+    0x62436220u, 0x62056567u, 0x62446468u, 0x6286616du, 0x62436265u, 0x62056573u, 0x6244646eu, 0x82c40866u,
+    0x61836520u, 0x62046874u, 0x62046861u, 0x6286612eu, 0x61836565u, 0x62856c6cu, 0x62046869u, 0x62c7744au,
+    0x62036f20u, 0x62856c64u, 0x62046868u, 0x6286616bu, 0x62036f65u, 0x62856c72u, 0x6204686eu, 0x82c40826u,
+    0x61c36920u, 0x62846674u, 0x62846661u, 0x62866163u, 0x61c36965u, 0x62856c6fu, 0x62846669u, 0x62c8202du,
+    0x62837620u, 0x62856c67u, 0x62846668u, 0x62866175u, 0x62837665u, 0x62856c73u, 0x6284666eu, 0x82c408a6u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x5186002cu, 0x61832065u, 0x6245696cu, 0x61c46569u, 0x51860077u,
+    0x62036720u, 0x62456964u, 0x61c46568u, 0x51860066u, 0x62036765u, 0x62456972u, 0x61c4656eu, 0x82c40806u,
+    0x61c36820u, 0x62447274u, 0x62447261u, 0x51860062u, 0x61c36865u, 0x6245696fu, 0x62447269u, 0x62c77479u,
+    0x62436d20u, 0x62456967u, 0x62447268u, 0x5186006du, 0x62436d65u, 0x62456973u, 0x6244726eu, 0x82c40886u,
+    0x61836520u, 0x62046e74u, 0x62046e61u, 0x5186002eu, 0x61836565u, 0x62c5776cu, 0x62046e69u, 0x62c77470u,
+    0x62037320u, 0x62c57764u, 0x62046e68u, 0x5186006bu, 0x62037365u, 0x62c57772u, 0x62046e6eu, 0x82c40846u,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x51860063u, 0x61c36e65u, 0x62c5776fu, 0x51040069u, 0x52490042u,
+    0x50c30020u, 0x62c57767u, 0x51040068u, 0x51860075u, 0x50c30065u, 0x62c57773u, 0x5104006eu, 0x82c408c6u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6246652cu, 0x61832065u, 0x6205206cu, 0x61c42069u, 0x62466577u,
+    0x61c37420u, 0x62052064u, 0x61c42068u, 0x62466566u, 0x61c37465u, 0x62052072u, 0x61c4206eu, 0x52490049u,
+    0x61c36120u, 0x62047474u, 0x62047461u, 0x62466562u, 0x61c36165u, 0x6205206fu, 0x62047469u, 0x62c76176u,
+    0x62432e20u, 0x62052067u, 0x62047468u, 0x6246656du, 0x62432e65u, 0x62052073u, 0x6204746eu, 0x82c4085eu,
+    0x61836520u, 0x62046174u, 0x62046161u, 0x6246652eu, 0x61836565u, 0x6285646cu, 0x62046169u, 0x62c7614au,
+    0x62036c20u, 0x62856464u, 0x62046168u, 0x6246656bu, 0x62036c65u, 0x62856472u, 0x6204616eu, 0x82c4081eu,
+    0x61c36920u, 0x62846274u, 0x62846261u, 0x62466563u, 0x61c36965u, 0x6285646fu, 0x62846269u, 0x52080021u,
+    0x62834a20u, 0x62856467u, 0x62846268u, 0x62466575u, 0x62834a65u, 0x62856473u, 0x6284626eu, 0x82c4089eu,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x62c66c2cu, 0x61832065u, 0x6245686cu, 0x61c46569u, 0x62c66c77u,
+    0x62036420u, 0x62456864u, 0x61c46568u, 0x62c66c66u, 0x62036465u, 0x62456872u, 0x61c4656eu, 0x52cb00ffu,
+    0x61c36820u, 0x62446f74u, 0x62446f61u, 0x62c66c62u, 0x61c36865u, 0x6245686fu, 0x62446f69u, 0x62c76179u,
+    0x62436b20u, 0x62456867u, 0x62446f68u, 0x62c66c6du, 0x62436b65u, 0x62456873u, 0x62446f6eu, 0x82c4087eu,
+    0x61836520u, 0x62046974u, 0x62046961u, 0x62c66c2eu, 0x61836565u, 0x62c5666cu, 0x62046969u, 0x62c76170u,
+    0x62037220u, 0x62c56664u, 0x62046968u, 0x62c66c6bu, 0x62037265u, 0x62c56672u, 0x6204696eu, 0x82c4083eu,
+    0x61c36e20u, 0x62c47674u, 0x62c47661u, 0x62c66c63u, 0x61c36e65u, 0x62c5666fu, 0x62c47669u, 0x52080054u,
+    0x50c30020u, 0x62c56667u, 0x62c47668u, 0x62c66c75u, 0x50c30065u, 0x62c56673u, 0x62c4766eu, 0x82c408beu,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6286692cu, 0x61832065u, 0x6205656cu, 0x61c42069u, 0x62866977u,
+    0x61c37420u, 0x62056564u, 0x61c42068u, 0x62866966u, 0x61c37465u, 0x62056572u, 0x61c4206eu, 0x528a004fu,
+    0x61c36120u, 0x62446774u, 0x62446761u, 0x62866962u, 0x61c36165u, 0x6205656fu, 0x62446769u, 0x51c70076u,
+    0x62436320u, 0x62056567u, 0x62446768u, 0x6286696du, 0x62436365u, 0x62056573u, 0x6244676eu, 0x82c4086eu,
+    0x61836520u, 0x62046874u, 0x62046861u, 0x6286692eu, 0x61836565u, 0x6285726cu, 0x62046869u, 0x51c7004au,
+    0x62036f20u, 0x62857264u, 0x62046868u, 0x6286696bu, 0x62036f65u, 0x62857272u, 0x6204686eu, 0x82c4082eu,
+    0x61c36920u, 0x62846d74u, 0x62846d61u, 0x62866963u, 0x61c36965u, 0x6285726fu, 0x62846d69u, 0x5208002du,
+    0x62c32120u, 0x62857267u, 0x62846d68u, 0x62866975u, 0x62c32165u, 0x62857273u, 0x62846d6eu, 0x82c408aeu,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x5186002cu, 0x61832065u, 0x62456e6cu, 0x61c46569u, 0x51860077u,
+    0x62036720u, 0x62456e64u, 0x61c46568u, 0x51860066u, 0x62036765u, 0x62456e72u, 0x61c4656eu, 0x82c4080eu,
+    0x61c36820u, 0x62447374u, 0x62447361u, 0x51860062u, 0x61c36865u, 0x62456e6fu, 0x62447369u, 0x51c70079u,
+    0x62437520u, 0x62456e67u, 0x62447368u, 0x5186006du, 0x62437565u, 0x62456e73u, 0x6244736eu, 0x82c4088eu,
+    0x61836520u, 0x62046e74u, 0x62046e61u, 0x5186002eu, 0x61836565u, 0x5145006cu, 0x62046e69u, 0x51c70070u,
+    0x62037320u, 0x51450064u, 0x62046e68u, 0x5186006bu, 0x62037365u, 0x51450072u, 0x62046e6eu, 0x82c4084eu,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x51860063u, 0x61c36e65u, 0x5145006fu, 0x51040069u, 0x52490046u,
+    0x50c30020u, 0x51450067u, 0x51040068u, 0x51860075u, 0x50c30065u, 0x51450073u, 0x5104006eu, 0x82c408ceu,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6246202cu, 0x61832065u, 0x6205206cu, 0x61c42069u, 0x62462077u,
+    0x61c37420u, 0x62052064u, 0x61c42068u, 0x62462066u, 0x61c37465u, 0x62052072u, 0x61c4206eu, 0x52490048u,
+    0x61c36120u, 0x62047474u, 0x62047461u, 0x62462062u, 0x61c36165u, 0x6205206fu, 0x62047469u, 0x62876576u,
+    0x62432c20u, 0x62052067u, 0x62047468u, 0x6246206du, 0x62432c65u, 0x62052073u, 0x6204746eu, 0x82c4085au,
+    0x61836520u, 0x62046174u, 0x62046161u, 0x6246202eu, 0x61836565u, 0x6245746cu, 0x62046169u, 0x6287654au,
+    0x62036c20u, 0x62457464u, 0x62046168u, 0x6246206bu, 0x62036c65u, 0x62457472u, 0x6204616eu, 0x82c4081au,
+    0x61c36920u, 0x62842e74u, 0x62842e61u, 0x62462063u, 0x61c36965u, 0x6245746fu, 0x62842e69u, 0x52080021u,
+    0x62437720u, 0x62457467u, 0x62842e68u, 0x62462075u, 0x62437765u, 0x62457473u, 0x62842e6eu, 0x82c4089au,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x62c6642cu, 0x61832065u, 0x6245616cu, 0x61c46569u, 0x62c66477u,
+    0x62036420u, 0x62456164u, 0x61c46568u, 0x62c66466u, 0x62036465u, 0x62456172u, 0x61c4656eu, 0x52cb00fdu,
+    0x61c36820u, 0x62446c74u, 0x62446c61u, 0x62c66462u, 0x61c36865u, 0x6245616fu, 0x62446c69u, 0x62876579u,
+    0x62436620u, 0x62456167u, 0x62446c68u, 0x62c6646du, 0x62436665u, 0x62456173u, 0x62446c6eu, 0x82c4087au,
+    0x61836520u, 0x62046974u, 0x62046961u, 0x62c6642eu, 0x61836565u, 0x62c5626cu, 0x62046969u, 0x62876570u,
+    0x62037220u, 0x62c56264u, 0x62046968u, 0x62c6646bu, 0x62037265u, 0x62c56272u, 0x6204696eu, 0x82c4083au,
+    0x61c36e20u, 0x62c44a74u, 0x62c44a61u, 0x62c66463u, 0x61c36e65u, 0x62c5626fu, 0x62c44a69u, 0x52080054u,
+    0x50c30020u, 0x62c56267u, 0x62c44a68u, 0x62c66475u, 0x50c30065u, 0x62c56273u, 0x62c44a6eu, 0x82c408bau,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6286682cu, 0x61832065u, 0x6205656cu, 0x61c42069u, 0x62866877u,
+    0x61c37420u, 0x62056564u, 0x61c42068u, 0x62866866u, 0x61c37465u, 0x62056572u, 0x61c4206eu, 0x528a0045u,
+    0x61c36120u, 0x62446474u, 0x62446461u, 0x62866862u, 0x61c36165u, 0x6205656fu, 0x62446469u, 0x51c70076u,
+    0x62436220u, 0x62056567u, 0x62446468u, 0x6286686du, 0x62436265u, 0x62056573u, 0x6244646eu, 0x82c4086au,
+    0x61836520u, 0x62046874u, 0x62046861u, 0x6286682eu, 0x61836565u, 0x62856f6cu, 0x62046869u, 0x51c7004au,
+    0x62036f20u, 0x62856f64u, 0x62046868u, 0x6286686bu, 0x62036f65u, 0x62856f72u, 0x6204686eu, 0x82c4082au,
+    0x61c36920u, 0x62846b74u, 0x62846b61u, 0x62866863u, 0x61c36965u, 0x62856f6fu, 0x62846b69u, 0x5208002du,
+    0x62837920u, 0x62856f67u, 0x62846b68u, 0x62866875u, 0x62837965u, 0x62856f73u, 0x62846b6eu, 0x82c408aau,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x5186002cu, 0x61832065u, 0x6245696cu, 0x61c46569u, 0x51860077u,
+    0x62036720u, 0x62456964u, 0x61c46568u, 0x51860066u, 0x62036765u, 0x62456972u, 0x61c4656eu, 0x82c4080au,
+    0x61c36820u, 0x62447274u, 0x62447261u, 0x51860062u, 0x61c36865u, 0x6245696fu, 0x62447269u, 0x51c70079u,
+    0x62436d20u, 0x62456967u, 0x62447268u, 0x5186006du, 0x62436d65u, 0x62456973u, 0x6244726eu, 0x82c4088au,
+    0x61836520u, 0x62046e74u, 0x62046e61u, 0x5186002eu, 0x61836565u, 0x5145006cu, 0x62046e69u, 0x51c70070u,
+    0x62037320u, 0x51450064u, 0x62046e68u, 0x5186006bu, 0x62037365u, 0x51450072u, 0x62046e6eu, 0x82c4084au,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x51860063u, 0x61c36e65u, 0x5145006fu, 0x51040069u, 0x52490042u,
+    0x50c30020u, 0x51450067u, 0x51040068u, 0x51860075u, 0x50c30065u, 0x51450073u, 0x5104006eu, 0x82c408cau,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6246652cu, 0x61832065u, 0x6205206cu, 0x61c42069u, 0x62466577u,
+    0x61c37420u, 0x62052064u, 0x61c42068u, 0x62466566u, 0x61c37465u, 0x62052072u, 0x61c4206eu, 0x52490049u,
+    0x61c36120u, 0x62047474u, 0x62047461u, 0x62466562u, 0x61c36165u, 0x6205206fu, 0x62047469u, 0x62c76976u,
+    0x62432e20u, 0x62052067u, 0x62047468u, 0x6246656du, 0x62432e65u, 0x62052073u, 0x6204746eu, 0x82c40862u,
+    0x61836520u, 0x62046174u, 0x62046161u, 0x6246652eu, 0x61836565u, 0x6285676cu, 0x62046169u, 0x62c7694au,
+    0x62036c20u, 0x62856764u, 0x62046168u, 0x6246656bu, 0x62036c65u, 0x62856772u, 0x6204616eu, 0x82c40822u,
+    0x61c36920u, 0x62846374u, 0x62846361u, 0x62466563u, 0x61c36965u, 0x6285676fu, 0x62846369u, 0x52080021u,
+    0x62837020u, 0x62856767u, 0x62846368u, 0x62466575u, 0x62837065u, 0x62856773u, 0x6284636eu, 0x82c408a2u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x62c6722cu, 0x61832065u, 0x6245686cu, 0x61c46569u, 0x62c67277u,
+    0x62036420u, 0x62456864u, 0x61c46568u, 0x62c67266u, 0x62036465u, 0x62456872u, 0x61c4656eu, 0x82c40802u,
+    0x61c36820u, 0x62446f74u, 0x62446f61u, 0x62c67262u, 0x61c36865u, 0x6245686fu, 0x62446f69u, 0x62c76979u,
+    0x62436b20u, 0x62456867u, 0x62446f68u, 0x62c6726du, 0x62436b65u, 0x62456873u, 0x62446f6eu, 0x82c40882u,
+    0x61836520u, 0x62046974u, 0x62046961u, 0x62c6722eu, 0x61836565u, 0x62c56d6cu, 0x62046969u, 0x62c76970u,
+    0x62037220u, 0x62c56d64u, 0x62046968u, 0x62c6726bu, 0x62037265u, 0x62c56d72u, 0x6204696eu, 0x82c40842u,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x62c67263u, 0x61c36e65u, 0x62c56d6fu, 0x51040069u, 0x52080054u,
+    0x50c30020u, 0x62c56d67u, 0x51040068u, 0x62c67275u, 0x50c30065u, 0x62c56d73u, 0x5104006eu, 0x82c408c2u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x62866e2cu, 0x61832065u, 0x6205656cu, 0x61c42069u, 0x62866e77u,
+    0x61c37420u, 0x62056564u, 0x61c42068u, 0x62866e66u, 0x61c37465u, 0x62056572u, 0x61c4206eu, 0x528a0057u,
+    0x61c36120u, 0x62446774u, 0x62446761u, 0x62866e62u, 0x61c36165u, 0x6205656fu, 0x62446769u, 0x51c70076u,
+    0x62436320u, 0x62056567u, 0x62446768u, 0x62866e6du, 0x62436365u, 0x62056573u, 0x6244676eu, 0x82c40872u,
+    0x61836520u, 0x62046874u, 0x62046861u, 0x62866e2eu, 0x61836565u, 0x6285736cu, 0x62046869u, 0x51c7004au,
+    0x62036f20u, 0x62857364u, 0x62046868u, 0x62866e6bu, 0x62036f65u, 0x62857372u, 0x6204686eu, 0x82c40832u,
+    0x61c36920u, 0x62847574u, 0x62847561u, 0x62866e63u, 0x61c36965u, 0x6285736fu, 0x62847569u, 0x5208002du,
+    0x62c35420u, 0x62857367u, 0x62847568u, 0x62866e75u, 0x62c35465u, 0x62857373u, 0x6284756eu, 0x82c408b2u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x5186002cu, 0x61832065u, 0x62456e6cu, 0x61c46569u, 0x51860077u,
+    0x62036720u, 0x62456e64u, 0x61c46568u, 0x51860066u, 0x62036765u, 0x62456e72u, 0x61c4656eu, 0x82c40812u,
+    0x61c36820u, 0x62447374u, 0x62447361u, 0x51860062u, 0x61c36865u, 0x62456e6fu, 0x62447369u, 0x51c70079u,
+    0x62437520u, 0x62456e67u, 0x62447368u, 0x5186006du, 0x62437565u, 0x62456e73u, 0x6244736eu, 0x82c40892u,
+    0x61836520u, 0x62046e74u, 0x62046e61u, 0x5186002eu, 0x61836565u, 0x5145006cu, 0x62046e69u, 0x51c70070u,
+    0x62037320u, 0x51450064u, 0x62046e68u, 0x5186006bu, 0x62037365u, 0x51450072u, 0x62046e6eu, 0x82c40852u,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x51860063u, 0x61c36e65u, 0x5145006fu, 0x51040069u, 0x52490046u,
+    0x50c30020u, 0x51450067u, 0x51040068u, 0x51860075u, 0x50c30065u, 0x51450073u, 0x5104006eu, 0x82c408d2u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6246202cu, 0x61832065u, 0x6205206cu, 0x61c42069u, 0x62462077u,
+    0x61c37420u, 0x62052064u, 0x61c42068u, 0x62462066u, 0x61c37465u, 0x62052072u, 0x61c4206eu, 0x52490048u,
+    0x61c36120u, 0x62047474u, 0x62047461u, 0x62462062u, 0x61c36165u, 0x6205206fu, 0x62047469u, 0x62872076u,
+    0x62432c20u, 0x62052067u, 0x62047468u, 0x6246206du, 0x62432c65u, 0x62052073u, 0x6204746eu, 0x82c40858u,
+    0x61836520u, 0x62046174u, 0x62046161u, 0x6246202eu, 0x61836565u, 0x6245746cu, 0x62046169u, 0x6287204au,
+    0x62036c20u, 0x62457464u, 0x62046168u, 0x6246206bu, 0x62036c65u, 0x62457472u, 0x6204616eu, 0x82c40818u,
+    0x61c36920u, 0x62842c74u, 0x62842c61u, 0x62462063u, 0x61c36965u, 0x6245746fu, 0x62842c69u, 0x62c86521u,
+    0x62437720u, 0x62457467u, 0x62842c68u, 0x62462075u, 0x62437765u, 0x62457473u, 0x62842c6eu, 0x82c40898u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x6286742cu, 0x61832065u, 0x6245616cu, 0x61c46569u, 0x62867477u,
+    0x62036420u, 0x62456164u, 0x61c46568u, 0x62867466u, 0x62036465u, 0x62456172u, 0x61c4656eu, 0x52cb00fcu,
+    0x61c36820u, 0x62446c74u, 0x62446c61u, 0x62867462u, 0x61c36865u, 0x6245616fu, 0x62446c69u, 0x62872079u,
+    0x62436620u, 0x62456167u, 0x62446c68u, 0x6286746du, 0x62436665u, 0x62456173u, 0x62446c6eu, 0x82c40878u,
+    0x61836520u, 0x62046974u, 0x62046961u, 0x6286742eu, 0x61836565u, 0x62c52e6cu, 0x62046969u, 0x62872070u,
+    0x62037220u, 0x62c52e64u, 0x62046968u, 0x6286746bu, 0x62037265u, 0x62c52e72u, 0x6204696eu, 0x82c40838u,
+    0x61c36e20u, 0x62847774u, 0x62847761u, 0x62867463u, 0x61c36e65u, 0x62c52e6fu, 0x62847769u, 0x62c86554u,
+    0x50c30020u, 0x62c52e67u, 0x62847768u, 0x62867475u, 0x50c30065u, 0x62c52e73u, 0x6284776eu, 0x82c408b8u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6286612cu, 0x61832065u, 0x6205656cu, 0x61c42069u, 0x62866177u,
+    0x61c37420u, 0x62056564u, 0x61c42068u, 0x62866166u, 0x61c37465u, 0x62056572u, 0x61c4206eu, 0x528a0041u,
+    0x61c36120u, 0x62446474u, 0x62446461u, 0x62866162u, 0x61c36165u, 0x6205656fu, 0x62446469u, 0x51c70076u,
+    0x62436220u, 0x62056567u, 0x62446468u, 0x6286616du, 0x62436265u, 0x62056573u, 0x6244646eu, 0x82c40868u,
+    0x61836520u, 0x62046874u, 0x62046861u, 0x6286612eu, 0x61836565u, 0x62856c6cu, 0x62046869u, 0x51c7004au,
+    0x62036f20u, 0x62856c64u, 0x62046868u, 0x6286616bu, 0x62036f65u, 0x62856c72u, 0x6204686eu, 0x82c40828u,
+    0x61c36920u, 0x62846674u, 0x62846661u, 0x62866163u, 0x61c36965u, 0x62856c6fu, 0x62846669u, 0x62c8652du,
+    0x62837620u, 0x62856c67u, 0x62846668u, 0x62866175u, 0x62837665u, 0x62856c73u, 0x6284666eu, 0x82c408a8u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x5186002cu, 0x61832065u, 0x6245696cu, 0x61c46569u, 0x51860077u,
+    0x62036720u, 0x62456964u, 0x61c46568u, 0x51860066u, 0x62036765u, 0x62456972u, 0x61c4656eu, 0x82c40808u,
+    0x61c36820u, 0x62447274u, 0x62447261u, 0x51860062u, 0x61c36865u, 0x6245696fu, 0x62447269u, 0x51c70079u,
+    0x62436d20u, 0x62456967u, 0x62447268u, 0x5186006du, 0x62436d65u, 0x62456973u, 0x6244726eu, 0x82c40888u,
+    0x61836520u, 0x62046e74u, 0x62046e61u, 0x5186002eu, 0x61836565u, 0x5145006cu, 0x62046e69u, 0x51c70070u,
+    0x62037320u, 0x51450064u, 0x62046e68u, 0x5186006bu, 0x62037365u, 0x51450072u, 0x62046e6eu, 0x82c40848u,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x51860063u, 0x61c36e65u, 0x5145006fu, 0x51040069u, 0x52490042u,
+    0x50c30020u, 0x51450067u, 0x51040068u, 0x51860075u, 0x50c30065u, 0x51450073u, 0x5104006eu, 0x82c408c8u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6246652cu, 0x61832065u, 0x6205206cu, 0x61c42069u, 0x62466577u,
+    0x61c37420u, 0x62052064u, 0x61c42068u, 0x62466566u, 0x61c37465u, 0x62052072u, 0x61c4206eu, 0x52490049u,
+    0x61c36120u, 0x62047474u, 0x62047461u, 0x62466562u, 0x61c36165u, 0x6205206fu, 0x62047469u, 0x62c76876u,
+    0x62432e20u, 0x62052067u, 0x62047468u, 0x6246656du, 0x62432e65u, 0x62052073u, 0x6204746eu, 0x82c40860u,
+    0x61836520u, 0x62046174u, 0x62046161u, 0x6246652eu, 0x61836565u, 0x6285646cu, 0x62046169u, 0x62c7684au,
+    0x62036c20u, 0x62856464u, 0x62046168u, 0x6246656bu, 0x62036c65u, 0x62856472u, 0x6204616eu, 0x82c40820u,
+    0x61c36920u, 0x62846274u, 0x62846261u, 0x62466563u, 0x61c36965u, 0x6285646fu, 0x62846269u, 0x52080021u,
+    0x62834a20u, 0x62856467u, 0x62846268u, 0x62466575u, 0x62834a65u, 0x62856473u, 0x6284626eu, 0x82c408a0u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x62c66f2cu, 0x61832065u, 0x6245686cu, 0x61c46569u, 0x62c66f77u,
+    0x62036420u, 0x62456864u, 0x61c46568u, 0x62c66f66u, 0x62036465u, 0x62456872u, 0x61c4656eu, 0x82c40800u,
+    0x61c36820u, 0x62446f74u, 0x62446f61u, 0x62c66f62u, 0x61c36865u, 0x6245686fu, 0x62446f69u, 0x62c76879u,
+    0x62436b20u, 0x62456867u, 0x62446f68u, 0x62c66f6du, 0x62436b65u, 0x62456873u, 0x62446f6eu, 0x82c40880u,
+    0x61836520u, 0x62046974u, 0x62046961u, 0x62c66f2eu, 0x61836565u, 0x62c56b6cu, 0x62046969u, 0x62c76870u,
+    0x62037220u, 0x62c56b64u, 0x62046968u, 0x62c66f6bu, 0x62037265u, 0x62c56b72u, 0x6204696eu, 0x82c40840u,
+    0x61c36e20u, 0x62c47974u, 0x62c47961u, 0x62c66f63u, 0x61c36e65u, 0x62c56b6fu, 0x62c47969u, 0x52080054u,
+    0x50c30020u, 0x62c56b67u, 0x62c47968u, 0x62c66f75u, 0x50c30065u, 0x62c56b73u, 0x62c4796eu, 0x82c408c0u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6286692cu, 0x61832065u, 0x6205656cu, 0x61c42069u, 0x62866977u,
+    0x61c37420u, 0x62056564u, 0x61c42068u, 0x62866966u, 0x61c37465u, 0x62056572u, 0x61c4206eu, 0x528a004fu,
+    0x61c36120u, 0x62446774u, 0x62446761u, 0x62866962u, 0x61c36165u, 0x6205656fu, 0x62446769u, 0x51c70076u,
+    0x62436320u, 0x62056567u, 0x62446768u, 0x6286696du, 0x62436365u, 0x62056573u, 0x6244676eu, 0x82c40870u,
+    0x61836520u, 0x62046874u, 0x62046861u, 0x6286692eu, 0x61836565u, 0x6285726cu, 0x62046869u, 0x51c7004au,
+    0x62036f20u, 0x62857264u, 0x62046868u, 0x6286696bu, 0x62036f65u, 0x62857272u, 0x6204686eu, 0x82c40830u,
+    0x61c36920u, 0x62846d74u, 0x62846d61u, 0x62866963u, 0x61c36965u, 0x6285726fu, 0x62846d69u, 0x5208002du,
+    0x62c32d20u, 0x62857267u, 0x62846d68u, 0x62866975u, 0x62c32d65u, 0x62857273u, 0x62846d6eu, 0x82c408b0u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x5186002cu, 0x61832065u, 0x62456e6cu, 0x61c46569u, 0x51860077u,
+    0x62036720u, 0x62456e64u, 0x61c46568u, 0x51860066u, 0x62036765u, 0x62456e72u, 0x61c4656eu, 0x82c40810u,
+    0x61c36820u, 0x62447374u, 0x62447361u, 0x51860062u, 0x61c36865u, 0x62456e6fu, 0x62447369u, 0x51c70079u,
+    0x62437520u, 0x62456e67u, 0x62447368u, 0x5186006du, 0x62437565u, 0x62456e73u, 0x6244736eu, 0x82c40890u,
+    0x61836520u, 0x62046e74u, 0x62046e61u, 0x5186002eu, 0x61836565u, 0x5145006cu, 0x62046e69u, 0x51c70070u,
+    0x62037320u, 0x51450064u, 0x62046e68u, 0x5186006bu, 0x62037365u, 0x51450072u, 0x62046e6eu, 0x82c40850u,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x51860063u, 0x61c36e65u, 0x5145006fu, 0x51040069u, 0x52490046u,
+    0x50c30020u, 0x51450067u, 0x51040068u, 0x51860075u, 0x50c30065u, 0x51450073u, 0x5104006eu, 0x82c408d0u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6246202cu, 0x61832065u, 0x6205206cu, 0x61c42069u, 0x62462077u,
+    0x61c37420u, 0x62052064u, 0x61c42068u, 0x62462066u, 0x61c37465u, 0x62052072u, 0x61c4206eu, 0x52490048u,
+    0x61c36120u, 0x62047474u, 0x62047461u, 0x62462062u, 0x61c36165u, 0x6205206fu, 0x62047469u, 0x62876576u,
+    0x62432c20u, 0x62052067u, 0x62047468u, 0x6246206du, 0x62432c65u, 0x62052073u, 0x6204746eu, 0x82c4085cu,
+    0x61836520u, 0x62046174u, 0x62046161u, 0x6246202eu, 0x61836565u, 0x6245746cu, 0x62046169u, 0x6287654au,
+    0x62036c20u, 0x62457464u, 0x62046168u, 0x6246206bu, 0x62036c65u, 0x62457472u, 0x6204616eu, 0x82c4081cu,
+    0x61c36920u, 0x62842e74u, 0x62842e61u, 0x62462063u, 0x61c36965u, 0x6245746fu, 0x62842e69u, 0x52080021u,
+    0x62437720u, 0x62457467u, 0x62842e68u, 0x62462075u, 0x62437765u, 0x62457473u, 0x62842e6eu, 0x82c4089cu,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x62c6672cu, 0x61832065u, 0x6245616cu, 0x61c46569u, 0x62c66777u,
+    0x62036420u, 0x62456164u, 0x61c46568u, 0x62c66766u, 0x62036465u, 0x62456172u, 0x61c4656eu, 0x52cb00feu,
+    0x61c36820u, 0x62446c74u, 0x62446c61u, 0x62c66762u, 0x61c36865u, 0x6245616fu, 0x62446c69u, 0x62876579u,
+    0x62436620u, 0x62456167u, 0x62446c68u, 0x62c6676du, 0x62436665u, 0x62456173u, 0x62446c6eu, 0x82c4087cu,
+    0x61836520u, 0x62046974u, 0x62046961u, 0x62c6672eu, 0x61836565u, 0x62c5636cu, 0x62046969u, 0x62876570u,
+    0x62037220u, 0x62c56364u, 0x62046968u, 0x62c6676bu, 0x62037265u, 0x62c56372u, 0x6204696eu, 0x82c4083cu,
+    0x61c36e20u, 0x62c47074u, 0x62c47061u, 0x62c66763u, 0x61c36e65u, 0x62c5636fu, 0x62c47069u, 0x52080054u,
+    0x50c30020u, 0x62c56367u, 0x62c47068u, 0x62c66775u, 0x50c30065u, 0x62c56373u, 0x62c4706eu, 0x82c408bcu,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6286682cu, 0x61832065u, 0x6205656cu, 0x61c42069u, 0x62866877u,
+    0x61c37420u, 0x62056564u, 0x61c42068u, 0x62866866u, 0x61c37465u, 0x62056572u, 0x61c4206eu, 0x528a0045u,
+    0x61c36120u, 0x62446474u, 0x62446461u, 0x62866862u, 0x61c36165u, 0x6205656fu, 0x62446469u, 0x51c70076u,
+    0x62436220u, 0x62056567u, 0x62446468u, 0x6286686du, 0x62436265u, 0x62056573u, 0x6244646eu, 0x82c4086cu,
+    0x61836520u, 0x62046874u, 0x62046861u, 0x6286682eu, 0x61836565u, 0x62856f6cu, 0x62046869u, 0x51c7004au,
+    0x62036f20u, 0x62856f64u, 0x62046868u, 0x6286686bu, 0x62036f65u, 0x62856f72u, 0x6204686eu, 0x82c4082cu,
+    0x61c36920u, 0x62846b74u, 0x62846b61u, 0x62866863u, 0x61c36965u, 0x62856f6fu, 0x62846b69u, 0x5208002du,
+    0x62837920u, 0x62856f67u, 0x62846b68u, 0x62866875u, 0x62837965u, 0x62856f73u, 0x62846b6eu, 0x82c408acu,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x5186002cu, 0x61832065u, 0x6245696cu, 0x61c46569u, 0x51860077u,
+    0x62036720u, 0x62456964u, 0x61c46568u, 0x51860066u, 0x62036765u, 0x62456972u, 0x61c4656eu, 0x82c4080cu,
+    0x61c36820u, 0x62447274u, 0x62447261u, 0x51860062u, 0x61c36865u, 0x6245696fu, 0x62447269u, 0x51c70079u,
+    0x62436d20u, 0x62456967u, 0x62447268u, 0x5186006du, 0x62436d65u, 0x62456973u, 0x6244726eu, 0x82c4088cu,
+    0x61836520u, 0x62046e74u, 0x62046e61u, 0x5186002eu, 0x61836565u, 0x5145006cu, 0x62046e69u, 0x51c70070u,
+    0x62037320u, 0x51450064u, 0x62046e68u, 0x5186006bu, 0x62037365u, 0x51450072u, 0x62046e6eu, 0x82c4084cu,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x51860063u, 0x61c36e65u, 0x5145006fu, 0x51040069u, 0x52490042u,
+    0x50c30020u, 0x51450067u, 0x51040068u, 0x51860075u, 0x50c30065u, 0x51450073u, 0x5104006eu, 0x82c408ccu,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x6246652cu, 0x61832065u, 0x6205206cu, 0x61c42069u, 0x62466577u,
+    0x61c37420u, 0x62052064u, 0x61c42068u, 0x62466566u, 0x61c37465u, 0x62052072u, 0x61c4206eu, 0x52490049u,
+    0x61c36120u, 0x62047474u, 0x62047461u, 0x62466562u, 0x61c36165u, 0x6205206fu, 0x62047469u, 0x62c76e76u,
+    0x62432e20u, 0x62052067u, 0x62047468u, 0x6246656du, 0x62432e65u, 0x62052073u, 0x6204746eu, 0x82c40864u,
+    0x61836520u, 0x62046174u, 0x62046161u, 0x6246652eu, 0x61836565u, 0x6285676cu, 0x62046169u, 0x62c76e4au,
+    0x62036c20u, 0x62856764u, 0x62046168u, 0x6246656bu, 0x62036c65u, 0x62856772u, 0x6204616eu, 0x82c40824u,
+    0x61c36920u, 0x62846374u, 0x62846361u, 0x62466563u, 0x61c36965u, 0x6285676fu, 0x62846369u, 0x52080021u,
+    0x62837020u, 0x62856767u, 0x62846368u, 0x62466575u, 0x62837065u, 0x62856773u, 0x6284636eu, 0x82c408a4u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x62c6732cu, 0x61832065u, 0x6245686cu, 0x61c46569u, 0x62c67377u,
+    0x62036420u, 0x62456864u, 0x61c46568u, 0x62c67366u, 0x62036465u, 0x62456872u, 0x61c4656eu, 0x82c40804u,
+    0x61c36820u, 0x62446f74u, 0x62446f61u, 0x62c67362u, 0x61c36865u, 0x6245686fu, 0x62446f69u, 0x62c76e79u,
+    0x62436b20u, 0x62456867u, 0x62446f68u, 0x62c6736du, 0x62436b65u, 0x62456873u, 0x62446f6eu, 0x82c40884u,
+    0x61836520u, 0x62046974u, 0x62046961u, 0x62c6732eu, 0x61836565u, 0x62c5756cu, 0x62046969u, 0x62c76e70u,
+    0x62037220u, 0x62c57564u, 0x62046968u, 0x62c6736bu, 0x62037265u, 0x62c57572u, 0x6204696eu, 0x82c40844u,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x62c67363u, 0x61c36e65u, 0x62c5756fu, 0x51040069u, 0x52080054u,
+    0x50c30020u, 0x62c57567u, 0x51040068u, 0x62c67375u, 0x50c30065u, 0x62c57573u, 0x5104006eu, 0x82c408c4u,
+    0x61832020u, 0x61c42074u, 0x61c42061u, 0x62866e2cu, 0x61832065u, 0x6205656cu, 0x61c42069u, 0x62866e77u,
+    0x61c37420u, 0x62056564u, 0x61c42068u, 0x62866e66u, 0x61c37465u, 0x62056572u, 0x61c4206eu, 0x528a0057u,
+    0x61c36120u, 0x62446774u, 0x62446761u, 0x62866e62u, 0x61c36165u, 0x6205656fu, 0x62446769u, 0x51c70076u,
+    0x62436320u, 0x62056567u, 0x62446768u, 0x62866e6du, 0x62436365u, 0x62056573u, 0x6244676eu, 0x82c40874u,
+    0x61836520u, 0x62046874u, 0x62046861u, 0x62866e2eu, 0x61836565u, 0x6285736cu, 0x62046869u, 0x51c7004au,
+    0x62036f20u, 0x62857364u, 0x62046868u, 0x62866e6bu, 0x62036f65u, 0x62857372u, 0x6204686eu, 0x82c40834u,
+    0x61c36920u, 0x62847574u, 0x62847561u, 0x62866e63u, 0x61c36965u, 0x6285736fu, 0x62847569u, 0x5208002du,
+    0x50c30020u, 0x62857367u, 0x62847568u, 0x62866e75u, 0x50c30065u, 0x62857373u, 0x6284756eu, 0x82c408b4u,
+    0x61832020u, 0x61c46574u, 0x61c46561u, 0x5186002cu, 0x61832065u, 0x62456e6cu, 0x61c46569u, 0x51860077u,
+    0x62036720u, 0x62456e64u, 0x61c46568u, 0x51860066u, 0x62036765u, 0x62456e72u, 0x61c4656eu, 0x82c40814u,
+    0x61c36820u, 0x62447374u, 0x62447361u, 0x51860062u, 0x61c36865u, 0x62456e6fu, 0x62447369u, 0x51c70079u,
+    0x62437520u, 0x62456e67u, 0x62447368u, 0x5186006du, 0x62437565u, 0x62456e73u, 0x6244736eu, 0x82c40894u,
+    0x61836520u, 0x62046e74u, 0x62046e61u, 0x5186002eu, 0x61836565u, 0x5145006cu, 0x62046e69u, 0x51c70070u,
+    0x62037320u, 0x51450064u, 0x62046e68u, 0x5186006bu, 0x62037365u, 0x51450072u, 0x62046e6eu, 0x82c40854u,
+    0x61c36e20u, 0x51040074u, 0x51040061u, 0x51860063u, 0x61c36e65u, 0x5145006fu, 0x51040069u, 0x52490046u,
+    0x50c30020u, 0x51450067u, 0x51040068u, 0x51860075u, 0x50c30065u, 0x51450073u, 0x5104006eu, 0x82c408d4u,
+    0x50410000u, 0x50410001u, 0x50410002u, 0x50410003u, 0x50410004u, 0x50410005u, 0x50410006u, 0x50410007u,
+    0x50410008u, 0x50410009u, 0x5041000au, 0x5041000bu, 0x5041000cu, 0x5041000du, 0x5041000eu, 0x5041000fu,
+    0x50410010u, 0x50410011u, 0x50410012u, 0x50410013u, 0x50410014u, 0x50410015u, 0x50410016u, 0x50410017u,
+    0x50410018u, 0x50410019u, 0x5041001au, 0x5041001bu, 0x5041001cu, 0x5041001du, 0x5041001eu, 0x5041001fu,
+    0x50410022u, 0x50410023u, 0x50410024u, 0x50410025u, 0x50410026u, 0x50410027u, 0x50410028u, 0x50410029u,
+    0x5041002au, 0x5041002bu, 0x5041002fu, 0x50410030u, 0x50410031u, 0x50410032u, 0x50410033u, 0x50410034u,
+    0x50410035u, 0x50410036u, 0x50410037u, 0x50410038u, 0x50410039u, 0x5041003au, 0x5041003bu, 0x5041003cu,
+    0x5041003du, 0x5041003eu, 0x5041003fu, 0x50410040u, 0x50410043u, 0x50410044u, 0x50410047u, 0x5041004bu,
+    0x5041004cu, 0x5041004du, 0x5041004eu, 0x50410050u, 0x50410051u, 0x50410052u, 0x50410055u, 0x50410056u,
+    0x50410058u, 0x50410059u, 0x5041005au, 0x5041005bu, 0x5041005cu, 0x5041005du, 0x5041005eu, 0x5041005fu,
+    0x50410060u, 0x5041006au, 0x50410071u, 0x50410078u, 0x5041007au, 0x5041007bu, 0x5041007cu, 0x5041007du,
+    0x5041007eu, 0x5041007fu, 0x50410080u, 0x50410081u, 0x50410082u, 0x50410083u, 0x50410084u, 0x50410085u,
+    0x50410086u, 0x50410087u, 0x50410088u, 0x50410089u, 0x5041008au, 0x5041008bu, 0x5041008cu, 0x5041008du,
+    0x5041008eu, 0x5041008fu, 0x50410090u, 0x50410091u, 0x50410092u, 0x50410093u, 0x50410094u, 0x50410095u,
+    0x50410096u, 0x50410097u, 0x50410098u, 0x50410099u, 0x5041009au, 0x5041009bu, 0x5041009cu, 0x5041009du,
+    0x5041009eu, 0x5041009fu, 0x504100a0u, 0x504100a1u, 0x504100a2u, 0x504100a3u, 0x504100a4u, 0x504100a5u,
+    0x504100a6u, 0x504100a7u, 0x504100a8u, 0x504100a9u, 0x504100aau, 0x504100abu, 0x504100acu, 0x504100adu,
+    0x504100aeu, 0x504100afu, 0x504100b0u, 0x504100b1u, 0x504100b2u, 0x504100b3u, 0x504100b4u, 0x504100b5u,
+    0x504100b6u, 0x504100b7u, 0x504100b8u, 0x504100b9u, 0x504100bau, 0x504100bbu, 0x504100bcu, 0x504100bdu,
+    0x504100beu, 0x504100bfu, 0x504100c0u, 0x504100c1u, 0x504100c2u, 0x504100c3u, 0x504100c4u, 0x504100c5u,
+    0x504100c6u, 0x504100c7u, 0x504100c8u, 0x504100c9u, 0x504100cau, 0x504100cbu, 0x504100ccu, 0x504100cdu,
+    0x504100ceu, 0x504100cfu, 0x504100d0u, 0x504100d1u, 0x504100d2u, 0x504100d3u, 0x504100d4u, 0x504100d5u,
+    0x504100d6u, 0x504100d7u, 0x504100d8u, 0x504100d9u, 0x504100dau, 0x504100dbu, 0x504100dcu, 0x504100ddu,
+    0x504100deu, 0x504100dfu, 0x504100e0u, 0x504100e1u, 0x504100e2u, 0x504100e3u, 0x504100e4u, 0x504100e5u,
+    0x504100e6u, 0x504100e7u, 0x504100e8u, 0x504100e9u, 0x504100eau, 0x504100ebu, 0x504100ecu, 0x504100edu,
+    0x504100eeu, 0x504100efu, 0x504100f0u, 0x504100f1u, 0x504100f2u, 0x504100f3u, 0x504100f4u, 0x504100f5u,
+    0x504100f6u, 0x504100f7u, 0x504100f8u, 0x504100f9u, 0x504100fau, 0x504100fbu,
+};
+
+size_t wacky_beanstalk_bound(size_t length) {
+    return (length * 12 + 7) / 8;
+}
+
+bool wacky_beanstalk_encode(
+    const uint8_t* data, size_t length, uint8_t* out, size_t capacity,
+    size_t* out_size) {
+    uint8_t* start = out;
+    uint8_t* end = out + capacity;
+    uint64_t accumulator = 0;
+    int pending = 0;
+    for (size_t i = 0; i < length; i++) {
+        int code_length = wacky_beanstalk_code_lengths[data[i]];
+        accumulator |= (uint64_t)wacky_beanstalk_code_bits[data[i]] << pending;
+        pending += code_length;
+        if (pending >= 32) {
+            if (end - out < 4) {
+                return false;
+            }
+            out[0] = (uint8_t)accumulator;
+            out[1] = (uint8_t)(accumulator >> 8);
+            out[2] = (uint8_t)(accumulator >> 16);
+            out[3] = (uint8_t)(accumulator >> 24);
+            out += 4;
+            accumulator >>= 32;
+            pending -= 32;
+        }
+    }
+    for (; pending > 0; pending -= 8) {
+        if (out == end) {
+            return false;
+        }
+        *out++ = (uint8_t)accumulator;
+        accumulator >>= 8;
+    }
+    *out_size = out - start;
+    return true;
+}
+
+bool wacky_beanstalk_decode(
+    const uint8_t* in, size_t in_size, uint8_t* out, size_t out_length) {
+    uint8_t* end = out + out_length;
+    uint64_t accumulator = 0;
+    int available = 0;
+    size_t position = 0;
+    while (out < end) {
+        if (available < 12) {
+            if (position + 8 <= in_size) {
+                uint64_t word = 0;
+                for (int b = 0; b < 8; b++) {
+                    word |= (uint64_t)in[position + b] << (8 * b);
+                }
+                accumulator |= word << available;
+                int bytes = (63 - available) / 8;
+                position += bytes;
+                available += bytes * 8;
+            } else {
+                while (available <= 56 && position < in_size) {
+                    accumulator |= (uint64_t)in[position++] << available;
+                    available += 8;
+                }
+            }
+        }
+        uint32_t entry = wacky_beanstalk_decode_slots[accumulator & 0x7ffu];
+        int consumed = 0;
+        while (entry >> 30 == 2) {
+            consumed += (entry >> 22) & 63;
+            uint64_t mask = ((uint64_t)1 << ((entry >> 18) & 15)) - 1;
+            size_t slot = (entry & 0x3ffffu) + ((accumulator >> consumed) & mask);
+            entry = wacky_beanstalk_decode_slots[slot];
+        }
+        int used = consumed + ((entry >> 16) & 63);
+        if (entry >> 30 != 1 || used > available) {
+            return false;
+        }
+        *out++ = (uint8_t)entry;
+        int pair_bits = (entry >> 22) & 63;
+        if (((entry >> 28) & 3) == 2 && pair_bits <= available && out < end) {
+            *out++ = (uint8_t)(entry >> 8);
+            used = pair_bits;
+        }
+        accumulator >>= used;
+        available -= used;
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+#ifndef WACKY_BITS_C
+#define WACKY_BITS_C
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define WACKY_ACCUMULATOR_BITS 64
+
+/**
+ * The one output path for every encoder: codes are ORed into a 64-bit
+ * accumulator and written out 32 bits at a time.
+ *
+ * Bit k of the output is bit (k % 8) of byte k / 8, so the result is the same
+ * on every host. Between calls to bit_writer_put() fewer than 32 bits are
+ * pending, which leaves room for any code of up to 32 bits with one shift and
+ * one OR; longer codes are split in two.
+ */
+typedef struct WackyBitWriter WackyBitWriter;
+struct WackyBitWriter {
+    uint64_t accumulator;
+    int pending;
+    uint8_t* out;
+    uint8_t* end;
+};
+
+void bit_writer_init(WackyBitWriter* writer, uint8_t* out, size_t capacity) {
+    writer->accumulator = 0;
+    writer->pending = 0;
+    writer->out = out;
+    writer->end = out + capacity;
+}
+
+/**
+ * Points the writer at a new output buffer, keeping any pending bits. Used by
+ * the streaming encoder, which gets a fresh buffer on every call.
+ */
+void bit_writer_set_output(WackyBitWriter* writer, uint8_t* out,
+                           size_t capacity) {
+    writer->out = out;
+    writer->end = out + capacity;
+}
+
+/**
+ * ORs `length` bits into the accumulator. The caller guarantees that
+ * pending + length <= 64.
+ */
+static inline void bit_writer_append(WackyBitWriter* writer, uint64_t bits,
+                                     int length) {
+    writer->accumulator |= bits << writer->pending;
+    writer->pending += length;
+}
+
+/**
+ * Writes every whole byte that is pending and fits in the output.
+ */
+static inline void bit_writer_flush_bytes(WackyBitWriter* writer) {
+    while (writer->pending >= CHAR_BIT && writer->out < writer->end) {
+        *writer->out++ = (uint8_t)writer->accumulator;
+        writer->accumulator >>= CHAR_BIT;
+        writer->pending -= CHAR_BIT;
+    }
+}
+
+/**
+ * Writes the low 32 pending bits as one little-endian word if there are that
+ * many, falling back to single bytes near the end of the output.
+ */
+static inline void bit_writer_flush_word(WackyBitWriter* writer) {
+    if (writer->pending < 32) {
+        return;
+    }
+    if (writer->end - writer->out < 4) {
+        bit_writer_flush_bytes(writer);
+        return;
+    }
+    uint32_t word = (uint32_t)writer->accumulator;
+    writer->out[0] = (uint8_t)word;
+    writer->out[1] = (uint8_t)(word >> 8);
+    writer->out[2] = (uint8_t)(word >> 16);
+    writer->out[3] = (uint8_t)(word >> 24);
+    writer->out += 4;
+    writer->accumulator >>= 32;
+    writer->pending -= 32;
+}
+
+/**
+ * Appends a whole code of 0 to 64 bits.
+ *
+ * @return false, writing nothing, if the output has no room for the code
+ * along with the bits already pending.
+ */
+static inline bool bit_writer_put(WackyBitWriter* writer, uint64_t bits,
+                                  int length) {
+    if ((size_t)(writer->end - writer->out) * CHAR_BIT <
+        (size_t)(writer->pending + length)) {
+        return false;
+    }
+    if (length > 32) {
+        bit_writer_append(writer, bits & 0xFFFFFFFFu, 32);
+        bit_writer_flush_word(writer);
+        bits >>= 32;
+        length -= 32;
+    }
+    bit_writer_append(writer, bits, length);
+    bit_writer_flush_word(writer);
+    return true;
+}
+
+/**
+ * Pads the pending bits with zeros up to a byte boundary and writes them out.
+ *
+ * @return true if everything was written, false if the output is full (call
+ * again after bit_writer_set_output()).
+ */
+bool bit_writer_finish(WackyBitWriter* writer) {
+    if (writer->pending % CHAR_BIT != 0) {
+        writer->pending += CHAR_BIT - writer->pending % CHAR_BIT;
+    }
+    bit_writer_flush_bytes(writer);
+    return writer->pending == 0;
+}
+
+bool host_is_little_endian() {
+    const uint16_t probe = 1;
+    return *(const uint8_t*)&probe == 1;
+}
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef WACKY_BLOCKS_C
+#define WACKY_BLOCKS_C
+
+#include "wacky_container.c"
+
+/**
+ * Block mode: the input is cut into fixed-size blocks and each block is coded
+ * with a tree built from its own histogram, so the codes follow statistics
+ * that drift through the input. The container starts like the one in
+ * wacky_container.c, with WACKY_CONTAINER_BLOCKS set in the flags:
+ *
+ *   bytes 0-13  magic, version, flags, total symbol count
+ *   8 bytes     block size in bytes, 64-bit little-endian
+ *   per block   one WackyBlockType byte
+ *               the code lengths, see write_wacky_header(), for
+ *               WACKY_BLOCK_NEW_TABLE only
+ *               8 bytes of payload size, 64-bit little-endian
+ *               the payload, see encode_bytes_to_stream()
+ *
+ * Every block holds block-size symbols except the last, which holds the rest.
+ */
+
+#define WACKY_DEFAULT_BLOCK_SIZE ((size_t)256 << 10)
+// Bounds the memory a decoder must set aside for one block.
+#define WACKY_MAX_BLOCK_SIZE ((size_t)4 << 20)
+
+typedef enum {
+    // A header with the block's own code lengths follows.
+    WACKY_BLOCK_NEW_TABLE = 0,
+    // The block uses the codes of the block before it.
+    WACKY_BLOCK_REUSE_TABLE = 1,
+} WackyBlockType;
+
+/**
+ * Makes sure `*buffer` has room for `needed` bytes, doubling its capacity as
+ * required.
+ */
+bool reserve_block_output(uint8_t** buffer, size_t* capacity, size_t needed) {
+    if (needed <= *capacity) {
+        return true;
+    }
+    size_t new_capacity = MAX(*capacity * 2, needed);
+    uint8_t* grown = realloc(*buffer, new_capacity);
+    if (grown == NULL) {
+        return false;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    *buffer = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/**
+ * Given a buffer of bytes, this function encodes it one block at a time.
+ * For every block it compares the cost of a fresh tree, header included,
+ * against coding the block with the previous block's codes, and keeps the
+ * cheaper one.
+ *
+ * @param data The bytes to be encoded.
+ * @param length The number of bytes at `data`.
+ * @param block_size Bytes per block, or 0 for WACKY_DEFAULT_BLOCK_SIZE.
+ * Clamped to WACKY_MAX_BLOCK_SIZE.
+ * @param out_size Set to the size of the returned container.
+ * @param tables_written If not NULL, set to the number of blocks that carry
+ * their own code table.
+ *
+ * @return A new container the caller must free, or NULL if memory runs out
+ * or a block cannot be encoded.
+ */
+uint8_t* wacky_compress_blocks(const uint8_t* data, size_t length,
+                               size_t block_size, size_t* out_size,
+                               size_t* tables_written) {
+    if ((data == NULL && length > 0) || out_size == NULL) {
+        return NULL;
+    }
+    block_size = block_size > 0 ? MIN(block_size, WACKY_MAX_BLOCK_SIZE)
+                                : WACKY_DEFAULT_BLOCK_SIZE;
+
+    size_t capacity = WACKY_CONTAINER_PREFIX_SIZE + 8 + length / 2;
+    uint8_t* out = malloc(capacity);
+    if (out == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    memcpy(out, WACKY_CONTAINER_MAGIC, WACKY_CONTAINER_MAGIC_SIZE);
+    out[4] = WACKY_CONTAINER_VERSION;
+    out[5] = WACKY_CONTAINER_BLOCKS;
+    store_le64(&out[6], length);
+    store_le64(&out[WACKY_CONTAINER_PREFIX_SIZE], block_size);
+    size_t position = WACKY_CONTAINER_PREFIX_SIZE + 8;
+
+    WackyCodeTable previous;
+    WackyCodeTable fresh;
+    bool have_previous = false;
+    size_t new_tables = 0;
+    uint8_t header[WACKY_MAX_HEADER_SIZE];
+
+    for (size_t start = 0; start < length; start += block_size) {
+        const uint8_t* block = &data[start];
+        size_t block_length = MIN(block_size, length - start);
+        uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+        compute_byte_histogram(counts, block, block_length);
+        if (!build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH,
+                                        &fresh)) {
+            free(out);
+            return NULL;
+        }
+        size_t header_size = write_wacky_header(&fresh, header, sizeof(header));
+        uint64_t fresh_bits =
+            count_encoded_bits(&fresh, counts) + header_size * CHAR_BIT;
+        // UINT64_MAX when some byte of this block has no code in `previous`.
+        uint64_t reuse_bits = have_previous
+                                  ? count_encoded_bits(&previous, counts)
+                                  : UINT64_MAX;
+
+        bool reuse = reuse_bits <= fresh_bits;
+        if (!reuse) {
+            previous = fresh;
+            have_previous = true;
+            new_tables++;
+        }
+        uint64_t payload_bits = count_encoded_bits(&previous, counts);
+        size_t payload_size = (payload_bits + CHAR_BIT - 1) / CHAR_BIT;
+        size_t block_bytes =
+            1 + (reuse ? 0 : header_size) + 8 + payload_size;
+        if (!reserve_block_output(&out, &capacity, position + block_bytes)) {
+            free(out);
+            return NULL;
+        }
+
+        out[position++] = reuse ? WACKY_BLOCK_REUSE_TABLE : WACKY_BLOCK_NEW_TABLE;
+        if (!reuse) {
+            memcpy(&out[position], header, header_size);
+            position += header_size;
+        }
+        store_le64(&out[position], payload_size);
+        position += 8;
+        size_t written;
+        if (!encode_bytes_to_stream(&previous, block, block_length,
+                                    &out[position], payload_size, &written)) {
+            free(out);
+            return NULL;
+        }
+        position += written;
+    }
+
+    if (tables_written != NULL) {
+        *tables_written = new_tables;
+    }
+    *out_size = position;
+    return out;
+}
+
+/**
+ * Decodes a container written by wacky_compress_blocks().
+ *
+ * @param in The container bytes.
+ * @param size The number of bytes at `in`.
+ * @param out_length Set to the number of decoded bytes.
+ *
+ * @return A new buffer the caller must free, or NULL if the container is
+ * corrupt.
+ */
+uint8_t* wacky_decompress_blocks(const uint8_t* in, size_t size,
+                                 size_t* out_length) {
+    size_t position = WACKY_CONTAINER_PREFIX_SIZE + 8;
+    if (in == NULL || out_length == NULL || size < position ||
+        memcmp(in, WACKY_CONTAINER_MAGIC, WACKY_CONTAINER_MAGIC_SIZE) != 0 ||
+        in[4] != WACKY_CONTAINER_VERSION || in[5] != WACKY_CONTAINER_BLOCKS) {
+        return NULL;
+    }
+    uint64_t length = read_le64(&in[6]);
+    uint64_t block_size = read_le64(&in[WACKY_CONTAINER_PREFIX_SIZE]);
+    if (block_size == 0 || block_size > WACKY_MAX_BLOCK_SIZE) {
+        return NULL;
+    }
+    // Rounded up without adding to `length`, which may be hostile. Each block
+    // costs at least its type byte and payload size, so the blocks must fit
+    // in the input left before anything is allocated for them.
+    uint64_t block_count = length / block_size + (length % block_size != 0);
+    if (block_count > (size - position) / 9) {
+        return NULL;
+    }
+
+    uint8_t* out = malloc(MAX(length, 1));
+    if (out == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    WackyCodeTable codes;
+    WackyDecodeTable table;
+    bool have_table = false;
+    bool ok = true;
+
+    for (uint64_t start = 0; ok && start < length; start += block_size) {
+        size_t block_length = MIN(block_size, length - start);
+        if (position >= size) {
+            ok = false;
+            break;
+        }
+        uint8_t type = in[position++];
+        if (type == WACKY_BLOCK_NEW_TABLE) {
+            size_t header_size =
+                read_wacky_header(&in[position], size - position, &codes);
+            if (have_table) {
+                free_wacky_decode_table(&table);
+                have_table = false;
+            }
+            if (header_size == 0 || !build_wacky_decode_table(&codes, &table)) {
+                ok = false;
+                break;
+            }
+            have_table = true;
+            position += header_size;
+        } else if (type != WACKY_BLOCK_REUSE_TABLE || !have_table) {
+            ok = false;
+            break;
+        }
+
+        if (size - position < 8) {
+            ok = false;
+            break;
+        }
+        uint64_t payload_size = read_le64(&in[position]);
+        position += 8;
+        ok = payload_size <= size - position &&
+             wacky_payload_can_hold(payload_size, block_length,
+                                    table.min_length) &&
+             decode_bytes_with_table(&table, &in[position], payload_size,
+                                     &out[start], block_length);
+        position += payload_size;
+    }
+
+    if (have_table) {
+        free_wacky_decode_table(&table);
+    }
+    if (!ok) {
+        free(out);
+        return NULL;
+    }
+    *out_length = length;
+    return out;
+}
+
+#endif
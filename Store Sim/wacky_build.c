@@ -0,0 +1,188 @@
+#ifndef WACKY_BUILD_C
+#define WACKY_BUILD_C
+
+#include "wackman.c"
+
+/**
+ * A tree waiting to be merged. Ties on weight are broken the same way
+ * create_wacky_list() and merge_wacky_list() order their list: branches come
+ * before leaves, newer branches before older ones, and leaves by character.
+ */
+typedef struct WackyHeapItem WackyHeapItem;
+struct WackyHeapItem {
+    WackyTreeNode* node;
+    bool is_branch;
+    int order;
+};
+
+typedef struct WackyHeap WackyHeap;
+struct WackyHeap {
+    WackyHeapItem* items;
+    int size;
+};
+
+bool heap_item_less(WackyHeapItem* a, WackyHeapItem* b) {
+    if (a->node->count != b->node->count) {
+        return a->node->count < b->node->count;
+    }
+    if (a->is_branch != b->is_branch) {
+        return a->is_branch;
+    }
+    // Leaves are ordered by character, branches by newest first.
+    return a->is_branch ? a->order > b->order : a->order < b->order;
+}
+
+void heap_sift_down(WackyHeap* heap, int index) {
+    while (true) {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = 2 * index + 2;
+        if (left < heap->size &&
+            heap_item_less(&heap->items[left], &heap->items[smallest])) {
+            smallest = left;
+        }
+        if (right < heap->size &&
+            heap_item_less(&heap->items[right], &heap->items[smallest])) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            return;
+        }
+        WackyHeapItem temp = heap->items[index];
+        heap->items[index] = heap->items[smallest];
+        heap->items[smallest] = temp;
+        index = smallest;
+    }
+}
+
+void heap_sift_up(WackyHeap* heap, int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!heap_item_less(&heap->items[index], &heap->items[parent])) {
+            return;
+        }
+        WackyHeapItem temp = heap->items[index];
+        heap->items[index] = heap->items[parent];
+        heap->items[parent] = temp;
+        index = parent;
+    }
+}
+
+WackyHeapItem heap_pop(WackyHeap* heap) {
+    WackyHeapItem top = heap->items[0];
+    heap->items[0] = heap->items[--heap->size];
+    heap_sift_down(heap, 0);
+    return top;
+}
+
+void heap_push(WackyHeap* heap, WackyHeapItem item) {
+    heap->items[heap->size++] = item;
+    heap_sift_up(heap, heap->size - 1);
+}
+
+void discard_heap_trees(WackyArena* arena, WackyHeap* heap) {
+    for (int i = 0; i < heap->size; i++) {
+        discard_wacky_trees(arena, &heap->items[i].node, 1);
+    }
+}
+
+/**
+ * Given 64-bit occurrence counts, this function builds the same WackyTree as
+ * merge_wacky_list(create_wacky_list(counts)) in O(n log n), using a binary
+ * heap in a single flat array instead of a sorted linked list. Only the exact
+ * counts are compared, so the tree depends on nothing but the counts.
+ *
+ * @param arena Where to allocate the nodes, or NULL to malloc each one.
+ * @param counts The number of occurrences of each character. Their sum must
+ * fit in 64 bits.
+ * @param alphabet_size The length of `counts`, either
+ * ASCII_CHARACTER_SET_SIZE or WACKY_BYTE_ALPHABET_SIZE.
+ *
+ * @return The root of the new WackyTree, or NULL if no character occurs or
+ * the nodes cannot be allocated.
+ */
+WackyTreeNode* build_wacky_tree_from_counts(WackyArena* arena,
+                                            const uint64_t counts[],
+                                            int alphabet_size) {
+    if (counts == NULL || alphabet_size > WACKY_BYTE_ALPHABET_SIZE) {
+        return NULL;
+    }
+    WACKY_STAGE_BEGIN(WACKY_STAGE_TREE);
+    uint64_t total = 0;
+    for (int i = 0; i < alphabet_size; i++) {
+        total += counts[i];
+    }
+
+    WackyHeapItem items[WACKY_BYTE_ALPHABET_SIZE];
+    WackyHeap heap = {items, 0};
+    for (int i = 0; i < alphabet_size; i++) {
+        if (counts[i] > 0) {
+            double weight = (double)counts[i] / total;
+            WackyTreeNode* leaf = arena_leaf_node(arena, counts[i], weight, i);
+            if (leaf == NULL) {
+                discard_heap_trees(arena, &heap);
+                return NULL;
+            }
+            heap.items[heap.size++] = (WackyHeapItem){leaf, false, i};
+        }
+    }
+    if (heap.size == 0) {
+        return NULL;
+    }
+    for (int i = heap.size / 2 - 1; i >= 0; i--) {
+        heap_sift_down(&heap, i);
+    }
+
+    // Every merge shrinks the heap by one, so it never outgrows `items`.
+    for (int branches = 0; heap.size > 1; branches++) {
+        WackyHeapItem first = heap_pop(&heap);
+        WackyHeapItem second = heap_pop(&heap);
+        WackyTreeNode* branch = arena_branch_node(arena, first.node, second.node);
+        if (branch == NULL) {
+            discard_wacky_trees(arena, &first.node, 1);
+            discard_wacky_trees(arena, &second.node, 1);
+            discard_heap_trees(arena, &heap);
+            return NULL;
+        }
+        heap_push(&heap, (WackyHeapItem){branch, true, branches});
+    }
+    WACKY_STAGE_END(WACKY_STAGE_TREE);
+    return heap.items[0].node;
+}
+
+/**
+ * build_wacky_tree_from_counts() for an int occurrence array.
+ */
+WackyTreeNode* build_wacky_tree_sized(WackyArena* arena, int occurrence_array[],
+                                      int alphabet_size) {
+    if (occurrence_array == NULL || alphabet_size > WACKY_BYTE_ALPHABET_SIZE) {
+        return NULL;
+    }
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE];
+    for (int i = 0; i < alphabet_size; i++) {
+        counts[i] = MAX(occurrence_array[i], 0);
+    }
+    return build_wacky_tree_from_counts(arena, counts, alphabet_size);
+}
+
+WackyTreeNode* build_wacky_tree_in(WackyArena* arena,
+                                   int occurrence_array[ASCII_CHARACTER_SET_SIZE]) {
+    return build_wacky_tree_sized(arena, occurrence_array,
+                                  ASCII_CHARACTER_SET_SIZE);
+}
+
+WackyTreeNode* build_wacky_tree(int occurrence_array[ASCII_CHARACTER_SET_SIZE]) {
+    return build_wacky_tree_in(NULL, occurrence_array);
+}
+
+/**
+ * Builds a tree over all 256 byte values, as counted by
+ * compute_byte_occurrence_array(). Leaves hold the byte in val, so bytes
+ * above 127 read back negative through a plain char.
+ */
+WackyTreeNode* build_wacky_byte_tree(int occurrence_array[WACKY_BYTE_ALPHABET_SIZE]) {
+    return build_wacky_tree_sized(NULL, occurrence_array,
+                                  WACKY_BYTE_ALPHABET_SIZE);
+}
+
+#endif
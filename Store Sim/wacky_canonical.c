@@ -0,0 +1,239 @@
+#ifndef WACKY_CANONICAL_C
+#define WACKY_CANONICAL_C
+
+#include "wacky_codes.c"
+#include "wacky_decode.c"
+
+// Set in byte 2 of the header when a byte above 127 has a code, in which case
+// the bitmap covers all 256 byte values instead of the 128 ASCII ones.
+#define WACKY_HEADER_WIDE_FLAG 0x80
+#define WACKY_HEADER_DELTA_MASK 0x07
+// Symbol count, minimum length and delta width, then the presence bitmap and
+// up to 7 bits of length delta per symbol.
+#define WACKY_MAX_HEADER_SIZE                         \
+    (3 + WACKY_MAX_SYMBOLS / CHAR_BIT +               \
+     (WACKY_MAX_SYMBOLS * 7 + CHAR_BIT - 1) / CHAR_BIT)
+
+/**
+ * Returns the low `length` bits of `bits` in reverse order.
+ */
+uint64_t reverse_code_bits(uint64_t bits, int length) {
+    uint64_t reversed = 0;
+    for (int i = 0; i < length; i++) {
+        reversed = (reversed << 1) | ((bits >> i) & 1);
+    }
+    return reversed;
+}
+
+/**
+ * Given a code table, this function replaces every code with the canonical
+ * code of the same length. Symbols are ordered by (length, symbol) and each
+ * one gets the next binary number, so the lengths alone determine the codes.
+ * Compression is unchanged since no length changes.
+ *
+ * @param table The code table to rewrite. Only the lengths are read.
+ *
+ * @return false if the lengths do not form a valid prefix code.
+ */
+bool canonicalize_wacky_code_table(WackyCodeTable* table) {
+    if (table == NULL) {
+        return false;
+    }
+
+    // Counting sort of the symbols by length; symbols stay in order within
+    // each length.
+    int length_counts[WACKY_MAX_CODE_LENGTH + 1] = {0};
+    int symbol_count = 0;
+    table->max_length = 0;
+    for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+        int length = table->codes[i].length;
+        if (length > WACKY_MAX_CODE_LENGTH) {
+            return false;
+        }
+        if (length >= 0) {
+            length_counts[length]++;
+            symbol_count++;
+            table->max_length = MAX(table->max_length, length);
+        }
+    }
+    if (symbol_count == 0) {
+        return false;
+    }
+    if (length_counts[0] > 0) {
+        // Only a lone symbol may have the empty code.
+        return symbol_count == 1;
+    }
+
+    // The Kraft sum must not exceed 1, checked before any code is assigned so
+    // that over-subscribed lengths cannot wrap the codes below. `left` is the
+    // number of unused codes of each length; once it reaches
+    // WACKY_MAX_SYMBOLS it can no longer run out, so it is capped there
+    // rather than doubled past 64 bits.
+    int left = 1;
+    for (int length = 1; length <= table->max_length; length++) {
+        left = MIN(left * 2, WACKY_MAX_SYMBOLS) - length_counts[length];
+        if (left < 0) {
+            return false;
+        }
+    }
+
+    // next_code[l] is the first code of length l, built MSB first.
+    uint64_t next_code[WACKY_MAX_CODE_LENGTH + 1] = {0};
+    uint64_t code = 0;
+    for (int length = 1; length <= table->max_length; length++) {
+        code = (code + length_counts[length - 1]) << 1;
+        next_code[length] = code;
+    }
+
+    for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+        int length = table->codes[i].length;
+        if (length > 0) {
+            // Stored first-bit-first, like the rest of the code tables.
+            table->codes[i].bits = reverse_code_bits(next_code[length]++, length);
+        }
+    }
+    return true;
+}
+
+/**
+ * Given a canonical code table, this function writes a compact header holding
+ * only the code lengths:
+ *
+ *   byte 0      number of symbols - 1
+ *   byte 1      shortest code length
+ *   byte 2      bits per length delta (0..7), plus WACKY_HEADER_WIDE_FLAG
+ *   bitmap      one bit per character, set if the character has a code; 16
+ *               bytes for ASCII alphabets, 32 when the wide flag is set
+ *   deltas      (length - shortest) for each present character in order,
+ *               packed from the low bit of each byte
+ *
+ * @param table The code table to describe.
+ * @param out Where to write the header.
+ * @param capacity The size of `out`; WACKY_MAX_HEADER_SIZE is always enough.
+ *
+ * @return The number of bytes written, or 0 if the table is empty or `out` is
+ * too small.
+ */
+size_t write_wacky_header(WackyCodeTable* table, uint8_t* out,
+                          size_t capacity) {
+    if (table == NULL || out == NULL) {
+        return 0;
+    }
+
+    int symbol_count = 0;
+    int min_length = WACKY_MAX_CODE_LENGTH;
+    int max_length = 0;
+    int alphabet_size = ASCII_CHARACTER_SET_SIZE;
+    for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+        if (table->codes[i].length >= 0) {
+            symbol_count++;
+            alphabet_size = MAX(alphabet_size, i < ASCII_CHARACTER_SET_SIZE
+                                                   ? ASCII_CHARACTER_SET_SIZE
+                                                   : WACKY_BYTE_ALPHABET_SIZE);
+            min_length = MIN(min_length, table->codes[i].length);
+            max_length = MAX(max_length, table->codes[i].length);
+        }
+    }
+    if (symbol_count == 0) {
+        return 0;
+    }
+
+    int delta_bits = 0;
+    while ((1 << delta_bits) <= max_length - min_length) {
+        delta_bits++;
+    }
+    int bitmap_bytes = alphabet_size / CHAR_BIT;
+    size_t size = 3 + bitmap_bytes +
+                  (symbol_count * delta_bits + CHAR_BIT - 1) / CHAR_BIT;
+    if (size > capacity) {
+        return 0;
+    }
+
+    memset(out, 0, size);
+    out[0] = symbol_count - 1;
+    out[1] = min_length;
+    out[2] = delta_bits;
+    if (alphabet_size == WACKY_BYTE_ALPHABET_SIZE) {
+        out[2] |= WACKY_HEADER_WIDE_FLAG;
+    }
+    uint8_t* bitmap = &out[3];
+    uint8_t* deltas = &out[3 + bitmap_bytes];
+    size_t bit_index = 0;
+    for (int i = 0; i < alphabet_size; i++) {
+        if (table->codes[i].length < 0) {
+            continue;
+        }
+        bitmap[i / CHAR_BIT] |= 1 << (i % CHAR_BIT);
+        int delta = table->codes[i].length - min_length;
+        for (int b = 0; b < delta_bits; b++, bit_index++) {
+            if ((delta >> b) & 1) {
+                deltas[bit_index / CHAR_BIT] |= 1 << (bit_index % CHAR_BIT);
+            }
+        }
+    }
+    return size;
+}
+
+/**
+ * Reads a header written by write_wacky_header() and rebuilds the canonical
+ * code table it describes. No tree is needed.
+ *
+ * @param in The header bytes.
+ * @param size The number of bytes available at `in`.
+ * @param table The code table to fill.
+ *
+ * @return The number of header bytes consumed, or 0 if the header is
+ * truncated, declares a code longer than WACKY_MAX_DECODE_LENGTH, or does not
+ * describe a valid code.
+ */
+size_t read_wacky_header(const uint8_t* in, size_t size,
+                         WackyCodeTable* table) {
+    if (in == NULL || table == NULL || size < 3) {
+        return 0;
+    }
+
+    int symbol_count = in[0] + 1;
+    int min_length = in[1];
+    int delta_bits = in[2] & WACKY_HEADER_DELTA_MASK;
+    int alphabet_size = (in[2] & WACKY_HEADER_WIDE_FLAG)
+                            ? WACKY_BYTE_ALPHABET_SIZE
+                            : ASCII_CHARACTER_SET_SIZE;
+    int bitmap_bytes = alphabet_size / CHAR_BIT;
+    size_t header_size = 3 + bitmap_bytes +
+                         (symbol_count * delta_bits + CHAR_BIT - 1) / CHAR_BIT;
+    if ((in[2] & ~(WACKY_HEADER_WIDE_FLAG | WACKY_HEADER_DELTA_MASK)) != 0 ||
+        header_size > size) {
+        return 0;
+    }
+
+    const uint8_t* bitmap = &in[3];
+    const uint8_t* deltas = &in[3 + bitmap_bytes];
+    size_t bit_index = 0;
+    int found = 0;
+    for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+        table->codes[i].bits = 0;
+        table->codes[i].length = -1;
+        if (i >= alphabet_size ||
+            !((bitmap[i / CHAR_BIT] >> (i % CHAR_BIT)) & 1)) {
+            continue;
+        }
+        if (++found > symbol_count) {
+            return 0;
+        }
+        int delta = 0;
+        for (int b = 0; b < delta_bits; b++, bit_index++) {
+            delta |= ((deltas[bit_index / CHAR_BIT] >> (bit_index % CHAR_BIT)) & 1)
+                     << b;
+        }
+        table->codes[i].length = min_length + delta;
+        if (table->codes[i].length > WACKY_MAX_DECODE_LENGTH) {
+            return 0;
+        }
+    }
+    if (found != symbol_count || !canonicalize_wacky_code_table(table)) {
+        return 0;
+    }
+    return header_size;
+}
+
+#endif
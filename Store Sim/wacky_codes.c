@@ -0,0 +1,271 @@
+#ifndef WACKY_CODES_C
+#define WACKY_CODES_C
+
+#include <stdint.h>
+
+#include "wackman.c"
+#include "wacky_bits.c"
+
+#define WACKY_MAX_SYMBOLS WACKY_BYTE_ALPHABET_SIZE
+#define WACKY_MAX_CODE_LENGTH 64
+#define WACKY_WORD_BITS 32
+
+/**
+ * A single code word. The first bit of the code (the first branch taken from
+ * the root) is stored in bit 0 of `bits`, so codes can be appended to an
+ * output word with a shift and an OR. A `length` of -1 means the symbol is not
+ * present in the tree.
+ */
+typedef struct WackyCode WackyCode;
+struct WackyCode {
+    uint64_t bits;
+    int length;
+};
+
+typedef struct WackyCodeTable WackyCodeTable;
+struct WackyCodeTable {
+    WackyCode codes[WACKY_MAX_SYMBOLS];
+    int max_length;
+};
+
+/**
+ * Recursive helper for build_wacky_code_table(). Walks every leaf once and
+ * records the path taken to reach it.
+ *
+ * @return false if a code would be longer than WACKY_MAX_CODE_LENGTH.
+ */
+bool code_table_helper(WackyCodeTable* table, WackyTreeNode* node,
+                       uint64_t bits, int depth) {
+    if (is_wacky_leaf(node)) {
+        unsigned char symbol = (unsigned char)node->val;
+        table->codes[symbol].bits = bits;
+        table->codes[symbol].length = depth;
+        table->max_length = MAX(table->max_length, depth);
+        return true;
+    }
+    if (depth >= WACKY_MAX_CODE_LENGTH) {
+        return false;
+    }
+
+    // Going left appends a 0 bit, going right appends a 1 bit.
+    if (node->left != NULL &&
+        !code_table_helper(table, node->left, bits, depth + 1)) {
+        return false;
+    }
+    if (node->right != NULL &&
+        !code_table_helper(table, node->right, bits | ((uint64_t)1 << depth),
+                           depth + 1)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Given the root of a WackyTree, this function fills `table` with the code of
+ * every character in the tree with a single traversal. Characters that are not
+ * in the tree get a length of -1.
+ *
+ * @param tree Pointer to the root of the WackyTree.
+ * @param table The code table to fill.
+ *
+ * @return true on success, false if the tree is empty or has a code longer
+ * than WACKY_MAX_CODE_LENGTH bits.
+ */
+bool build_wacky_code_table(WackyTreeNode* tree, WackyCodeTable* table) {
+    if (table == NULL) {
+        return false;
+    }
+    WACKY_STAGE_BEGIN(WACKY_STAGE_CODE_TABLE);
+    for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+        table->codes[i].bits = 0;
+        table->codes[i].length = -1;
+    }
+    table->max_length = 0;
+    if (tree == NULL || !code_table_helper(table, tree, 0, 0)) {
+        return false;
+    }
+    WACKY_STAGE_END(WACKY_STAGE_CODE_TABLE);
+    WACKY_COUNT(WACKY_STAT_TREES_BUILT, 1);
+    WACKY_RAISE(WACKY_STAT_MAX_CODE_LENGTH, table->max_length);
+    return true;
+}
+
+/**
+ * Given a code table and a buffer of raw bytes, this function returns the
+ * integer array encoding of the buffer: the length at index 0, then the bits
+ * packed from bit 0 of index 1 onwards. Any byte value, including '\0', can
+ * be encoded as long as it has a code.
+ *
+ * @param table A code table built by build_wacky_code_table().
+ * @param data The bytes to be encoded.
+ * @param length The number of bytes at `data`.
+ *
+ * @return A dynamically allocated integer array representing the encoding of
+ * the input, or NULL if any byte cannot be encoded.
+ */
+int* encode_bytes_with_table(WackyCodeTable* table, const unsigned char* data,
+                             int length) {
+    if (table == NULL || data == NULL || length <= 0) {
+        return NULL;
+    }
+
+    // Size the output exactly up front instead of growing it.
+    size_t total_bits = 0;
+    for (int i = 0; i < length; i++) {
+        if (table->codes[data[i]].length < 0) {
+            printf("Could not find coding for byte 0x%02x, aborting...\n",
+                   data[i]);
+            return NULL;
+        }
+        total_bits += table->codes[data[i]].length;
+    }
+
+    size_t word_count = (total_bits + WACKY_WORD_BITS - 1) / WACKY_WORD_BITS;
+    int* return_int_buffer = calloc(1 + MAX(word_count, 1), sizeof(int));
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    if (return_int_buffer == NULL) {
+        return NULL;
+    }
+
+    WackyBitWriter writer;
+    bit_writer_init(&writer, (uint8_t*)&return_int_buffer[1],
+                    word_count * sizeof(int));
+    for (int i = 0; i < length; i++) {
+        WackyCode code = table->codes[data[i]];
+        bit_writer_put(&writer, code.bits, code.length);
+    }
+    bit_writer_finish(&writer);
+
+    // The writer produces little-endian bytes; the integer array format wants
+    // bit k in bit (k % 32) of each int.
+    if (!host_is_little_endian()) {
+        uint8_t* bytes = (uint8_t*)&return_int_buffer[1];
+        for (size_t i = 0; i < word_count; i++, bytes += 4) {
+            return_int_buffer[1 + i] =
+                (int)((uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 |
+                      (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24);
+        }
+    }
+
+    return_int_buffer[0] = length;
+    return return_int_buffer;
+}
+
+/**
+ * Table-driven version of encode_string(). Produces exactly the same integer
+ * array, but costs one table lookup per character instead of a tree search.
+ *
+ * @param table A code table built by build_wacky_code_table().
+ * @param string The input string to be encoded.
+ *
+ * @return A dynamically allocated integer array representing the encoding of
+ * the input string, or NULL if any characters cannot be encoded.
+ */
+int* encode_string_with_table(WackyCodeTable* table, char* string) {
+    if (table == NULL || string == NULL || string[0] == '\0') {
+        return NULL;
+    }
+    size_t length = strlen(string);
+    if (length > INT_MAX) {
+        return NULL;
+    }
+    return encode_bytes_with_table(table, (const unsigned char*)string, length);
+}
+
+/**
+ * Returns the number of ints encode_bytes_with_table() returns for `data`,
+ * ints[0] included, which is what decode_ints_with_table() must be told. 0 if
+ * some byte in it has no code.
+ */
+size_t count_encoded_ints(WackyCodeTable* table, const unsigned char* data,
+                          int length) {
+    size_t total_bits = 0;
+    for (int i = 0; i < length; i++) {
+        if (table->codes[data[i]].length < 0) {
+            return 0;
+        }
+        total_bits += table->codes[data[i]].length;
+    }
+    size_t word_count = (total_bits + WACKY_WORD_BITS - 1) / WACKY_WORD_BITS;
+    return 1 + MAX(word_count, 1);
+}
+
+/**
+ * Returns the number of bits needed to encode a buffer with the given
+ * histogram, or UINT64_MAX if some byte in it has no code.
+ */
+uint64_t count_encoded_bits(WackyCodeTable* table,
+                            const uint64_t counts[WACKY_BYTE_ALPHABET_SIZE]) {
+    uint64_t total_bits = 0;
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        if (counts[i] == 0) {
+            continue;
+        }
+        if (table->codes[i].length < 0) {
+            return UINT64_MAX;
+        }
+        total_bits += counts[i] * table->codes[i].length;
+    }
+    return total_bits;
+}
+
+/**
+ * Appends the codes of `length` bytes to `writer`, leaving the stream open
+ * so that more can follow.
+ *
+ * @return false if a byte has no code or the output is full.
+ */
+static inline bool bit_writer_put_bytes(WackyBitWriter* writer,
+                                        WackyCodeTable* table,
+                                        const uint8_t* data, size_t length) {
+    WACKY_STAT(uint64_t bits = 0);
+    for (size_t i = 0; i < length; i++) {
+        WackyCode code = table->codes[data[i]];
+        if (code.length < 0 || !bit_writer_put(writer, code.bits, code.length)) {
+            return false;
+        }
+        WACKY_STAT(bits += code.length);
+    }
+    WACKY_COUNT(WACKY_STAT_SYMBOLS_ENCODED, length);
+    WACKY_COUNT(WACKY_STAT_BITS_EMITTED, bits);
+    return true;
+}
+
+/**
+ * Encodes a buffer of bytes into a byte stream instead of an integer array.
+ * Bit k of the stream is bit (k % 8) of byte k / 8, which matches the layout
+ * of the integer arrays on a little-endian machine. The last byte is padded
+ * with zero bits. Nothing is written past the last byte holding code bits, so
+ * several streams can be laid out back to back in one buffer.
+ *
+ * @param table A code table built by build_wacky_code_table().
+ * @param data The bytes to be encoded.
+ * @param length The number of bytes at `data`.
+ * @param out Where to write the stream.
+ * @param out_capacity The space at `out`; ceil(count_encoded_bits() / 8)
+ * bytes is exactly enough.
+ * @param out_size Set to the number of bytes written.
+ *
+ * @return false if a byte has no code or `out` is too small.
+ */
+bool encode_bytes_to_stream(WackyCodeTable* table, const uint8_t* data,
+                            size_t length, uint8_t* out, size_t out_capacity,
+                            size_t* out_size) {
+    if (table == NULL || (data == NULL && length > 0) || out_size == NULL) {
+        return false;
+    }
+    WACKY_STAGE_BEGIN(WACKY_STAGE_ENCODE);
+
+    WackyBitWriter writer;
+    bit_writer_init(&writer, out, out_capacity);
+    if (!bit_writer_put_bytes(&writer, table, data, length) ||
+        !bit_writer_finish(&writer)) {
+        return false;
+    }
+
+    *out_size = writer.out - out;
+    WACKY_STAGE_END(WACKY_STAGE_ENCODE);
+    return true;
+}
+
+#endif
@@ -0,0 +1,307 @@
+#ifndef WACKY_CONTAINER_C
+#define WACKY_CONTAINER_C
+
+#include "wacky_build.c"
+#include "wacky_canonical.c"
+#include "wacky_decode.c"
+#include "wacky_histogram.c"
+#include "wacky_limit.c"
+
+/**
+ * A self-describing, host-independent file format for encoded bytes:
+ *
+ *   bytes 0-3   magic "WACK"
+ *   byte 4      format version (WACKY_CONTAINER_VERSION)
+ *   byte 5      flags: 0, or one of the layouts below, which share the
+ *               first 14 bytes:
+ *                 WACKY_CONTAINER_BLOCKS  block mode, see wacky_blocks.c
+ *                 WACKY_CONTAINER_ORDER1  order-1 mode, see wacky_order1.c
+ *   bytes 6-13  number of symbols, 64-bit little-endian
+ *   header      the code lengths, see write_wacky_header(); absent when
+ *               there are no symbols
+ *   8 bytes     payload size in bytes, 64-bit little-endian
+ *   payload     the bit stream, see encode_bytes_to_stream()
+ *
+ * Every field is made of bytes in a fixed order, so files can be shared
+ * between hosts of any word size and endianness and read in place, e.g. from
+ * a mapped file.
+ */
+
+#define WACKY_CONTAINER_MAGIC "WACK"
+#define WACKY_CONTAINER_MAGIC_SIZE 4
+#define WACKY_CONTAINER_VERSION 1
+#define WACKY_CONTAINER_BLOCKS 0x01
+#define WACKY_CONTAINER_ORDER1 0x02
+#define WACKY_CONTAINER_PREFIX_SIZE (WACKY_CONTAINER_MAGIC_SIZE + 2 + 8)
+
+/**
+ * The parsed fields of a container. `payload` points into the container
+ * itself, so nothing is copied.
+ */
+typedef struct WackyContainer WackyContainer;
+struct WackyContainer {
+    int version;
+    uint64_t symbol_count;
+    WackyCodeTable codes;
+    const uint8_t* payload;
+    uint64_t payload_size;
+};
+
+static inline void store_le64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = (uint8_t)(value >> (i * CHAR_BIT));
+    }
+}
+
+static inline uint64_t read_le64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= (uint64_t)in[i] << (i * CHAR_BIT);
+    }
+    return value;
+}
+
+/**
+ * Whether `payload_size` bytes can hold `symbol_count` codes of at least
+ * `min_length` bits each. Decoders check this before sizing their output
+ * from a symbol count read from the input; `payload_size` must already be
+ * known to lie within the input. An empty code is only possible when it is
+ * the only one, and then any count fits.
+ */
+static inline bool wacky_payload_can_hold(uint64_t payload_size,
+                                          uint64_t symbol_count,
+                                          int min_length) {
+    return min_length == 0 ||
+           symbol_count <= payload_size * CHAR_BIT / (uint64_t)min_length;
+}
+
+/**
+ * Returns the length of the shortest code in `table`, or
+ * WACKY_MAX_CODE_LENGTH if it has none.
+ */
+static inline int shortest_code_length(const WackyCodeTable* table) {
+    int min_length = WACKY_MAX_CODE_LENGTH;
+    for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+        if (table->codes[i].length >= 0) {
+            min_length = MIN(min_length, table->codes[i].length);
+        }
+    }
+    return min_length;
+}
+
+/**
+ * Returns the largest container that encoding `length` bytes with codes of
+ * at most `max_length` bits can produce.
+ */
+size_t wacky_container_bound(size_t length, int max_length) {
+    return WACKY_CONTAINER_PREFIX_SIZE + WACKY_MAX_HEADER_SIZE + 8 +
+           (length * (size_t)max_length + CHAR_BIT - 1) / CHAR_BIT;
+}
+
+/**
+ * Returns the exact size of the container write_wacky_container() makes for
+ * input with the given byte counts, so the output can be sized up front, or
+ * 0 if a byte that occurs has no code.
+ */
+size_t wacky_container_size(WackyCodeTable* table,
+                            const uint64_t counts[WACKY_BYTE_ALPHABET_SIZE]) {
+    uint64_t symbol_count = 0;
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        symbol_count += counts[i];
+    }
+    uint64_t bits = count_encoded_bits(table, counts);
+    if (bits == UINT64_MAX) {
+        return 0;
+    }
+    size_t header_size = 0;
+    if (symbol_count > 0) {
+        uint8_t header[WACKY_MAX_HEADER_SIZE];
+        header_size = write_wacky_header(table, header, sizeof(header));
+    }
+    return WACKY_CONTAINER_PREFIX_SIZE + header_size + 8 +
+           (bits + CHAR_BIT - 1) / CHAR_BIT;
+}
+
+/**
+ * Given a canonical code table and a buffer of bytes, this function writes a
+ * complete container.
+ *
+ * @param table The codes to use. Must be canonical, since only the lengths
+ * are stored.
+ * @param data The bytes to be encoded.
+ * @param length The number of bytes at `data`.
+ * @param out Where to write the container.
+ * @param capacity The size of `out`; wacky_container_bound() is always
+ * enough.
+ *
+ * @return The size of the container, or 0 if a byte has no code or `out` is
+ * too small.
+ */
+size_t write_wacky_container(WackyCodeTable* table, const uint8_t* data,
+                             size_t length, uint8_t* out, size_t capacity) {
+    if (table == NULL || (data == NULL && length > 0) || out == NULL ||
+        capacity < WACKY_CONTAINER_PREFIX_SIZE + 8) {
+        return 0;
+    }
+
+    memcpy(out, WACKY_CONTAINER_MAGIC, WACKY_CONTAINER_MAGIC_SIZE);
+    out[4] = WACKY_CONTAINER_VERSION;
+    out[5] = 0;
+    store_le64(&out[6], length);
+    size_t position = WACKY_CONTAINER_PREFIX_SIZE;
+
+    if (length > 0) {
+        size_t header_size = write_wacky_header(
+            table, &out[position], capacity - position - 8);
+        if (header_size == 0) {
+            return 0;
+        }
+        position += header_size;
+    }
+
+    size_t payload_size = 0;
+    if (!encode_bytes_to_stream(table, data, length, &out[position + 8],
+                                capacity - position - 8, &payload_size)) {
+        return 0;
+    }
+    store_le64(&out[position], payload_size);
+    return position + 8 + payload_size;
+}
+
+/**
+ * Parses a container written by write_wacky_container() without copying the
+ * payload.
+ *
+ * @param in The container bytes.
+ * @param size The number of bytes at `in`.
+ * @param container The fields to fill.
+ *
+ * @return false if the magic or version is wrong, the code lengths are
+ * invalid, or the data is truncated.
+ */
+bool read_wacky_container(const uint8_t* in, size_t size,
+                          WackyContainer* container) {
+    if (in == NULL || container == NULL ||
+        size < WACKY_CONTAINER_PREFIX_SIZE + 8 ||
+        memcmp(in, WACKY_CONTAINER_MAGIC, WACKY_CONTAINER_MAGIC_SIZE) != 0 ||
+        in[4] != WACKY_CONTAINER_VERSION || in[5] != 0) {
+        return false;
+    }
+
+    container->version = in[4];
+    container->symbol_count = read_le64(&in[6]);
+    size_t position = WACKY_CONTAINER_PREFIX_SIZE;
+    if (container->symbol_count > 0) {
+        size_t header_size = read_wacky_header(&in[position], size - position,
+                                               &container->codes);
+        if (header_size == 0) {
+            return false;
+        }
+        position += header_size;
+    } else {
+        for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+            container->codes.codes[i].bits = 0;
+            container->codes.codes[i].length = -1;
+        }
+        container->codes.max_length = 0;
+    }
+
+    if (size - position < 8) {
+        return false;
+    }
+    container->payload_size = read_le64(&in[position]);
+    position += 8;
+    if (container->payload_size > size - position ||
+        (container->symbol_count > 0 &&
+         !wacky_payload_can_hold(container->payload_size,
+                                 container->symbol_count,
+                                 shortest_code_length(&container->codes)))) {
+        return false;
+    }
+    container->payload = &in[position];
+    return true;
+}
+
+/**
+ * Given a buffer of bytes, this function builds the best code for it and
+ * returns it as a container.
+ *
+ * @param data The bytes to be encoded.
+ * @param length The number of bytes at `data`.
+ * @param out_size Set to the size of the returned container.
+ *
+ * @return A new container the caller must free, or NULL if memory runs out.
+ */
+uint8_t* wacky_compress(const uint8_t* data, size_t length, size_t* out_size) {
+    if ((data == NULL && length > 0) || out_size == NULL) {
+        return NULL;
+    }
+
+    WackyCodeTable table = {.max_length = 0};
+    if (length > 0) {
+        uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+        compute_byte_histogram(counts, data, length);
+        if (!build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH, &table)) {
+            return NULL;
+        }
+    }
+
+    size_t capacity = wacky_container_bound(length, table.max_length);
+    uint8_t* out = malloc(capacity);
+    if (out == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    *out_size = write_wacky_container(&table, data, length, out, capacity);
+    if (*out_size == 0) {
+        free(out);
+        return NULL;
+    }
+    return out;
+}
+
+/**
+ * Decodes a container written by write_wacky_container() or
+ * wacky_compress().
+ *
+ * @param in The container bytes.
+ * @param size The number of bytes at `in`.
+ * @param out_length Set to the number of decoded bytes.
+ *
+ * @return A new buffer the caller must free, or NULL if the container is
+ * corrupt.
+ */
+uint8_t* wacky_decompress(const uint8_t* in, size_t size, size_t* out_length) {
+    WackyContainer container;
+    if (out_length == NULL || !read_wacky_container(in, size, &container) ||
+        container.symbol_count > SIZE_MAX - 1) {
+        return NULL;
+    }
+
+    uint8_t* out = malloc(MAX(container.symbol_count, 1));
+    if (out == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    *out_length = container.symbol_count;
+    if (container.symbol_count == 0) {
+        return out;
+    }
+
+    WackyDecodeTable table;
+    if (!build_wacky_decode_table(&container.codes, &table)) {
+        free(out);
+        return NULL;
+    }
+    bool decoded =
+        decode_bytes_with_table(&table, container.payload,
+                                container.payload_size, out, *out_length);
+    free_wacky_decode_table(&table);
+    if (!decoded) {
+        free(out);
+        return NULL;
+    }
+    return out;
+}
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef WACKY_CONTEXT_C
+#define WACKY_CONTEXT_C
+
+#include "wacky_decode.c"
+#include "wacky_limit.c"
+
+/**
+ * Long-lived encoder and decoder contexts for many small messages sharing one
+ * code. Everything that depends only on the code (the code table, the decode
+ * table) is built once at init; encoding and decoding a message then works
+ * entirely in caller-provided buffers and allocates nothing.
+ *
+ * A message is the symbol count as a LEB128 varint (7 bits per byte, low
+ * group first, high bit set on all but the last byte) followed by the bit
+ * stream of encode_bytes_to_stream().
+ */
+
+#define WACKY_MAX_VARINT_SIZE 10
+
+typedef struct WackyEncoderContext WackyEncoderContext;
+struct WackyEncoderContext {
+    WackyCodeTable codes;
+};
+
+typedef struct WackyDecoderContext WackyDecoderContext;
+struct WackyDecoderContext {
+    WackyCodeTable codes;
+    WackyDecodeTable table;
+};
+
+/**
+ * Writes `value` as a LEB128 varint.
+ *
+ * @return The number of bytes written, or 0 if `capacity` is too small.
+ */
+size_t write_wacky_varint(uint64_t value, uint8_t* out, size_t capacity) {
+    size_t size = 0;
+    do {
+        if (size == capacity) {
+            return 0;
+        }
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        out[size++] = byte | (value != 0 ? 0x80 : 0);
+    } while (value != 0);
+    return size;
+}
+
+/**
+ * Reads a LEB128 varint.
+ *
+ * @return The number of bytes read, or 0 if the varint is truncated or does
+ * not fit in 64 bits.
+ */
+size_t read_wacky_varint(const uint8_t* in, size_t size, uint64_t* value) {
+    *value = 0;
+    for (size_t i = 0; i < size && i < WACKY_MAX_VARINT_SIZE; i++) {
+        uint64_t group = in[i] & 0x7F;
+        if (i == WACKY_MAX_VARINT_SIZE - 1 && group > 1) {
+            return 0;
+        }
+        *value |= group << (7 * i);
+        if ((in[i] & 0x80) == 0) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Sets up an encoder for the codes of a prebuilt tree, which may be freed
+ * afterwards.
+ *
+ * @return false if the tree is empty or deeper than WACKY_MAX_CODE_LENGTH.
+ */
+bool wacky_encoder_init(WackyEncoderContext* context, WackyTreeNode* tree) {
+    return context != NULL && build_wacky_code_table(tree, &context->codes);
+}
+
+/**
+ * Sets up an encoder for the canonical codes of a byte histogram, limited so
+ * that a decoder can always be made for them.
+ *
+ * @return false if no byte occurs.
+ */
+bool wacky_encoder_init_from_counts(
+    WackyEncoderContext* context,
+    const uint64_t counts[WACKY_BYTE_ALPHABET_SIZE]) {
+    return context != NULL &&
+           build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH,
+                                      &context->codes);
+}
+
+/**
+ * Sets up an encoder for an existing code table, such as one loaded with
+ * wacky_load_dictionary().
+ */
+bool wacky_encoder_init_from_table(WackyEncoderContext* context,
+                                   WackyCodeTable* codes) {
+    if (context == NULL || codes == NULL) {
+        return false;
+    }
+    context->codes = *codes;
+    return true;
+}
+
+/**
+ * Returns the most bytes wacky_encode_message() can write for a message of
+ * `length` bytes.
+ */
+size_t wacky_message_bound(WackyEncoderContext* context, size_t length) {
+    return WACKY_MAX_VARINT_SIZE +
+           (length * (size_t)context->codes.max_length + CHAR_BIT - 1) /
+               CHAR_BIT;
+}
+
+/**
+ * Encodes one message. Allocates nothing.
+ *
+ * @param context An encoder set up by wacky_encoder_init().
+ * @param data The message.
+ * @param length The number of bytes at `data`.
+ * @param out Where to write the encoded message.
+ * @param capacity The size of `out`; wacky_message_bound() is always enough.
+ *
+ * @return The size of the encoded message, or 0 if a byte has no code or
+ * `out` is too small.
+ */
+size_t wacky_encode_message(WackyEncoderContext* context, const uint8_t* data,
+                            size_t length, uint8_t* out, size_t capacity) {
+    if (context == NULL || out == NULL) {
+        return 0;
+    }
+    size_t prefix = write_wacky_varint(length, out, capacity);
+    size_t payload_size;
+    if (prefix == 0 ||
+        !encode_bytes_to_stream(&context->codes, data, length, &out[prefix],
+                                capacity - prefix, &payload_size)) {
+        return 0;
+    }
+    return prefix + payload_size;
+}
+
+/**
+ * Sets up a decoder for a code table, building its decode table once.
+ * Release it with wacky_decoder_free().
+ *
+ * @return false if the codes are longer than WACKY_MAX_DECODE_LENGTH or
+ * memory runs out.
+ */
+bool wacky_decoder_init(WackyDecoderContext* context, WackyCodeTable* codes) {
+    if (context == NULL || codes == NULL) {
+        return false;
+    }
+    context->codes = *codes;
+    return build_wacky_decode_table(&context->codes, &context->table);
+}
+
+void wacky_decoder_free(WackyDecoderContext* context) {
+    if (context != NULL) {
+        free_wacky_decode_table(&context->table);
+    }
+}
+
+/**
+ * Decodes one message written by wacky_encode_message(). Allocates nothing.
+ *
+ * @param context A decoder for the codes the message was encoded with.
+ * @param in The encoded message.
+ * @param size The number of bytes at `in`.
+ * @param out Where to write the decoded bytes.
+ * @param capacity The size of `out`.
+ * @param out_length Set to the number of decoded bytes.
+ *
+ * @return false if the message is corrupt or longer than `capacity`.
+ */
+bool wacky_decode_message(WackyDecoderContext* context, const uint8_t* in,
+                          size_t size, uint8_t* out, size_t capacity,
+                          size_t* out_length) {
+    uint64_t length;
+    size_t prefix;
+    if (context == NULL || in == NULL || out_length == NULL ||
+        (prefix = read_wacky_varint(in, size, &length)) == 0 ||
+        length > capacity) {
+        return false;
+    }
+    *out_length = length;
+    return decode_bytes_with_table(&context->table, &in[prefix], size - prefix,
+                                   out, length);
+}
+
+#endif
@@ -0,0 +1,481 @@
+#ifndef WACKY_DECODE_C
+#define WACKY_DECODE_C
+
+#include "wacky_codes.c"
+
+#define WACKY_ROOT_TABLE_BITS 11
+#define WACKY_SUB_TABLE_BITS 8
+// The bit reader refills 32 bits at a time into a 64-bit accumulator, so any
+// single code must fit in one refill.
+#define WACKY_MAX_DECODE_LENGTH 32
+
+typedef enum {
+    WACKY_ENTRY_INVALID = 0,
+    WACKY_ENTRY_SYMBOLS,
+    WACKY_ENTRY_LINK,
+} WackyEntryType;
+
+/**
+ * One slot of a decode table, indexed by the next `width` bits of input.
+ *
+ * A WACKY_ENTRY_SYMBOLS slot resolves `count` (1 or 2) whole symbols that take
+ * `bits` bits in total, the first of which takes `first_bits`. A
+ * WACKY_ENTRY_LINK slot consumes `bits` bits and continues in the sub-table
+ * of 2^sub_bits slots starting at `link`.
+ */
+typedef struct WackyDecodeEntry WackyDecodeEntry;
+struct WackyDecodeEntry {
+    uint32_t link;
+    uint8_t symbols[2];
+    uint8_t type;
+    uint8_t count;
+    uint8_t bits;
+    uint8_t first_bits;
+    uint8_t sub_bits;
+};
+
+typedef struct WackyDecodeTable WackyDecodeTable;
+struct WackyDecodeTable {
+    WackyDecodeEntry* entries;
+    size_t entry_count;
+    int root_bits;
+    int min_length;
+    int max_length;
+    // Only used when the tree is a single leaf and every code is empty.
+    char single_symbol;
+};
+
+/**
+ * Reserves `count` new zeroed slots at the end of the table.
+ *
+ * @return The offset of the first new slot, or -1 if out of memory.
+ */
+long reserve_decode_entries(WackyDecodeTable* table, size_t count) {
+    WackyDecodeEntry* entries = realloc(
+        table->entries, (table->entry_count + count) * sizeof(WackyDecodeEntry));
+    if (entries == NULL) {
+        return -1;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    memset(&entries[table->entry_count], 0, count * sizeof(WackyDecodeEntry));
+    table->entries = entries;
+    table->entry_count += count;
+    return table->entry_count - count;
+}
+
+/**
+ * Fills the 2^width slots at `offset` for every code in `symbols` whose first
+ * `consumed` bits have already been read. Codes that do not fit are grouped
+ * by their next `width` bits and handed to a sub-table.
+ */
+bool fill_decode_level(WackyDecodeTable* table, WackyCodeTable* codes,
+                       size_t offset, int width, const uint8_t* symbols,
+                       int symbol_count, int consumed) {
+    uint64_t mask = ((uint64_t)1 << width) - 1;
+
+    for (int i = 0; i < symbol_count; i++) {
+        WackyCode code = codes->codes[symbols[i]];
+        int remaining = code.length - consumed;
+        uint64_t rest = code.bits >> consumed;
+        if (remaining > width) {
+            continue;
+        }
+
+        // Every index whose low `remaining` bits match the code decodes to it.
+        for (uint64_t j = rest; j <= mask; j += (uint64_t)1 << remaining) {
+            WackyDecodeEntry* entry = &table->entries[offset + j];
+            entry->type = WACKY_ENTRY_SYMBOLS;
+            entry->count = 1;
+            entry->symbols[0] = symbols[i];
+            entry->bits = remaining;
+            entry->first_bits = remaining;
+        }
+    }
+
+    // Only codes longer than `width` remain to be grouped.
+    if (symbol_count <= 0) {
+        return true;
+    }
+    uint8_t* group = malloc(symbol_count);
+    if (group == NULL) {
+        return false;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    for (int i = 0; i < symbol_count; i++) {
+        WackyCode code = codes->codes[symbols[i]];
+        uint64_t prefix = (code.bits >> consumed) & mask;
+        if (code.length - consumed <= width ||
+            table->entries[offset + prefix].type == WACKY_ENTRY_LINK) {
+            continue;
+        }
+
+        // Collect every long code sharing this prefix.
+        int group_count = 0;
+        int longest = 0;
+        for (int j = i; j < symbol_count; j++) {
+            WackyCode other = codes->codes[symbols[j]];
+            if (other.length - consumed > width &&
+                ((other.bits >> consumed) & mask) == prefix) {
+                group[group_count++] = symbols[j];
+                longest = MAX(longest, other.length - consumed - width);
+            }
+        }
+
+        int sub_bits = MIN(longest, WACKY_SUB_TABLE_BITS);
+        long sub_offset = reserve_decode_entries(table, (size_t)1 << sub_bits);
+        if (sub_offset < 0) {
+            free(group);
+            return false;
+        }
+        WackyDecodeEntry* entry = &table->entries[offset + prefix];
+        entry->type = WACKY_ENTRY_LINK;
+        entry->bits = width;
+        entry->sub_bits = sub_bits;
+        entry->link = sub_offset;
+
+        // The group is copied because the recursion reuses its own buffer.
+        uint8_t* members = malloc(group_count);
+        if (members == NULL) {
+            free(group);
+            return false;
+        }
+        WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+        memcpy(members, group, group_count);
+        bool ok = fill_decode_level(table, codes, sub_offset, sub_bits, members,
+                                    group_count, consumed + width);
+        free(members);
+        if (!ok) {
+            free(group);
+            return false;
+        }
+    }
+    free(group);
+    return true;
+}
+
+/**
+ * Lets every root slot whose symbol leaves enough known bits behind resolve
+ * the following symbol as well, so short codes decode two at a time.
+ */
+void pair_root_entries(WackyDecodeTable* table) {
+    size_t root_size = (size_t)1 << table->root_bits;
+    for (size_t i = 0; i < root_size; i++) {
+        WackyDecodeEntry* entry = &table->entries[i];
+        if (entry->type != WACKY_ENTRY_SYMBOLS) {
+            continue;
+        }
+        WackyDecodeEntry* next = &table->entries[i >> entry->first_bits];
+        int known_bits = table->root_bits - entry->first_bits;
+        if (next->type == WACKY_ENTRY_SYMBOLS && next->first_bits > 0 &&
+            next->first_bits <= known_bits) {
+            entry->count = 2;
+            entry->symbols[1] = next->symbols[0];
+            entry->bits = entry->first_bits + next->first_bits;
+        }
+    }
+}
+
+/**
+ * Given a code table, this function builds a multi-level lookup table that
+ * decodes up to WACKY_ROOT_TABLE_BITS bits per lookup. Codes longer than the
+ * root table continue in sub-tables of up to WACKY_SUB_TABLE_BITS bits.
+ *
+ * @param codes A code table built by build_wacky_code_table().
+ * @param table The decode table to fill. Release it with
+ * free_wacky_decode_table().
+ *
+ * @return true on success, false if there are no codes, a code is longer than
+ * WACKY_MAX_DECODE_LENGTH, or memory runs out.
+ */
+bool build_wacky_decode_table(WackyCodeTable* codes, WackyDecodeTable* table) {
+    if (codes == NULL || table == NULL) {
+        return false;
+    }
+    WACKY_STAGE_BEGIN(WACKY_STAGE_DECODE_TABLE);
+    table->entries = NULL;
+    table->entry_count = 0;
+    table->min_length = WACKY_MAX_CODE_LENGTH;
+    table->max_length = 0;
+    table->single_symbol = '\0';
+
+    uint8_t symbols[WACKY_MAX_SYMBOLS];
+    int symbol_count = 0;
+    for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+        if (codes->codes[i].length >= 0) {
+            symbols[symbol_count++] = i;
+            table->min_length = MIN(table->min_length, codes->codes[i].length);
+            table->max_length = MAX(table->max_length, codes->codes[i].length);
+        }
+    }
+    if (symbol_count == 0 || table->max_length > WACKY_MAX_DECODE_LENGTH) {
+        return false;
+    }
+    if (table->max_length == 0) {
+        table->root_bits = 0;
+        table->single_symbol = symbols[0];
+        WACKY_STAGE_END(WACKY_STAGE_DECODE_TABLE);
+        return true;
+    }
+
+    table->root_bits = MIN(table->max_length, WACKY_ROOT_TABLE_BITS);
+    if (reserve_decode_entries(table, (size_t)1 << table->root_bits) < 0 ||
+        !fill_decode_level(table, codes, 0, table->root_bits, symbols,
+                           symbol_count, 0)) {
+        free(table->entries);
+        table->entries = NULL;
+        return false;
+    }
+    pair_root_entries(table);
+    WACKY_STAGE_END(WACKY_STAGE_DECODE_TABLE);
+    return true;
+}
+
+void free_wacky_decode_table(WackyDecodeTable* table) {
+    if (table == NULL) {
+        return;
+    }
+    free(table->entries);
+    table->entries = NULL;
+    table->entry_count = 0;
+}
+
+/**
+ * Finds the slot for the bits at the bottom of `accumulator`, following
+ * sub-table links. `consumed` is set to the bits used by the links.
+ */
+static inline WackyDecodeEntry* lookup_decode_entry(WackyDecodeTable* table,
+                                                    uint64_t accumulator,
+                                                    int* consumed) {
+    WackyDecodeEntry* entry =
+        &table->entries[accumulator & (((uint64_t)1 << table->root_bits) - 1)];
+    *consumed = 0;
+    while (entry->type == WACKY_ENTRY_LINK) {
+        *consumed += entry->bits;
+        uint64_t index = (accumulator >> *consumed) &
+                         (((uint64_t)1 << entry->sub_bits) - 1);
+        entry = &table->entries[entry->link + index];
+    }
+    return entry;
+}
+
+/**
+ * Table-driven version of decode_ints(). Reads the same integer array format
+ * and returns a byte-identical string, resolving one or two symbols per
+ * lookup instead of following one pointer per bit.
+ *
+ * @param table A decode table built by build_wacky_decode_table().
+ * @param ints The input integer array to be decoded.
+ * @param int_count The number of ints at `ints`, ints[0] included (see
+ *        count_encoded_ints()). Nothing past them is read.
+ *
+ * @return A dynamically allocated string representing the decoded string,
+ *         or NULL if any characters cannot be decoded, or if ints[0] is
+ *         negative or more than the codes after it can hold. Binary data may
+ *         hold '\0' bytes, so its length should be taken from ints[0].
+ */
+char* decode_ints_with_table(WackyDecodeTable* table, int* ints,
+                             size_t int_count) {
+    if (table == NULL || ints == NULL || int_count == 0) {
+        return NULL;
+    }
+
+    int string_length = ints[0];
+    int* read_buffer = &ints[1];
+    int* read_end = &ints[int_count];
+    // Every symbol takes at least min_length bits, so a corrupt length is
+    // caught before it is allocated.
+    if (string_length < 0 ||
+        (table->max_length > 0 &&
+         (uint64_t)string_length * table->min_length >
+             (uint64_t)(int_count - 1) * WACKY_WORD_BITS)) {
+        return NULL;
+    }
+    char* output = malloc(((size_t)string_length + 1) * sizeof(char));
+    if (output == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+
+    if (table->max_length == 0) {
+        memset(output, table->single_symbol, string_length);
+        output[string_length] = '\0';
+        return output;
+    }
+
+    uint64_t accumulator = 0;
+    int available = 0;
+    int produced = 0;
+    while (produced < string_length) {
+        // Every remaining symbol takes at least min_length bits, so while
+        // there are more of those than we have buffered, the next word is
+        // part of the message; a corrupt one may still run off the end.
+        while (available <= WACKY_WORD_BITS &&
+               (uint64_t)(string_length - produced) * table->min_length >
+                   (uint64_t)available) {
+            if (read_buffer == read_end) {
+                free(output);
+                return NULL;
+            }
+            accumulator |= (uint64_t)(uint32_t)*read_buffer++ << available;
+            available += WACKY_WORD_BITS;
+        }
+
+        int consumed;
+        WackyDecodeEntry* entry =
+            lookup_decode_entry(table, accumulator, &consumed);
+        if (entry->type != WACKY_ENTRY_SYMBOLS) {
+            free(output);
+            return NULL;
+        }
+
+        // Near the end of the message the buffer may hold less than a full
+        // code; the code being decoded must then continue in the next word.
+        if (consumed + entry->first_bits > available) {
+            if (available > WACKY_WORD_BITS || read_buffer == read_end) {
+                free(output);
+                return NULL;
+            }
+            accumulator |= (uint64_t)(uint32_t)*read_buffer++ << available;
+            available += WACKY_WORD_BITS;
+            continue;
+        }
+
+        int used = consumed + entry->first_bits;
+        output[produced++] = entry->symbols[0];
+        if (entry->count == 2 && entry->bits <= available &&
+            produced < string_length) {
+            output[produced++] = entry->symbols[1];
+            used = entry->bits;
+        }
+        accumulator >>= used;
+        available -= used;
+    }
+
+    output[string_length] = '\0';
+    return output;
+}
+
+static inline uint64_t load_le64(const uint8_t* in) {
+    return (uint64_t)in[0] | (uint64_t)in[1] << 8 | (uint64_t)in[2] << 16 |
+           (uint64_t)in[3] << 24 | (uint64_t)in[4] << 32 |
+           (uint64_t)in[5] << 40 | (uint64_t)in[6] << 48 |
+           (uint64_t)in[7] << 56;
+}
+
+/**
+ * Reads a byte stream written by encode_bytes_to_stream(). Since the size of
+ * the stream is known, it can load eight bytes at a time and never touches
+ * memory past `size`.
+ */
+typedef struct WackyBitReader WackyBitReader;
+struct WackyBitReader {
+    const uint8_t* in;
+    size_t size;
+    size_t position;
+    uint64_t accumulator;
+    int available;
+};
+
+static inline void bit_reader_init(WackyBitReader* reader, const uint8_t* in,
+                                   size_t size) {
+    reader->in = in;
+    reader->size = size;
+    reader->position = 0;
+    reader->accumulator = 0;
+    reader->available = 0;
+}
+
+/**
+ * Tops the reader up to at least WACKY_MAX_DECODE_LENGTH bits, or to the end
+ * of the stream.
+ */
+static inline void bit_reader_refill(WackyBitReader* reader) {
+    if (reader->available >= WACKY_MAX_DECODE_LENGTH) {
+        return;
+    }
+    if (reader->position + sizeof(uint64_t) <= reader->size) {
+        // Bits past the whole bytes taken are loaded as well, but they are
+        // the same bits the next refill ORs in, so no harm done.
+        reader->accumulator |= load_le64(&reader->in[reader->position])
+                               << reader->available;
+        int bytes = (63 - reader->available) / CHAR_BIT;
+        reader->position += bytes;
+        reader->available += bytes * CHAR_BIT;
+    } else {
+        while (reader->available <= 56 && reader->position < reader->size) {
+            reader->accumulator |= (uint64_t)reader->in[reader->position++]
+                                   << reader->available;
+            reader->available += CHAR_BIT;
+        }
+    }
+}
+
+/**
+ * Decodes the next one or two symbols of a refilled reader into `*out`,
+ * never writing at or past `end`, and advances `*out`.
+ *
+ * @return false if the stream is truncated or holds an invalid code.
+ */
+static inline bool decode_next_symbols(WackyDecodeTable* table,
+                                       WackyBitReader* reader, uint8_t** out,
+                                       uint8_t* end) {
+    int consumed;
+    WackyDecodeEntry* entry =
+        lookup_decode_entry(table, reader->accumulator, &consumed);
+    int used = consumed + entry->first_bits;
+    if (entry->type != WACKY_ENTRY_SYMBOLS || used > reader->available) {
+        return false;
+    }
+
+    *(*out)++ = entry->symbols[0];
+    if (entry->count == 2 && entry->bits <= reader->available && *out < end) {
+        *(*out)++ = entry->symbols[1];
+        used = entry->bits;
+    }
+    reader->accumulator >>= used;
+    reader->available -= used;
+    return true;
+}
+
+/**
+ * Decodes a byte stream written by encode_bytes_to_stream().
+ *
+ * @param table A decode table built by build_wacky_decode_table().
+ * @param in The encoded stream.
+ * @param in_size The number of bytes at `in`.
+ * @param out Where to write the decoded bytes.
+ * @param out_length The number of bytes to decode.
+ *
+ * @return false if the stream is truncated or holds an invalid code.
+ */
+bool decode_bytes_with_table(WackyDecodeTable* table, const uint8_t* in,
+                             size_t in_size, uint8_t* out, size_t out_length) {
+    if (table == NULL || (in == NULL && in_size > 0) ||
+        (out == NULL && out_length > 0)) {
+        return false;
+    }
+    WACKY_STAGE_BEGIN(WACKY_STAGE_DECODE);
+    WACKY_COUNT(WACKY_STAT_SYMBOLS_DECODED, out_length);
+    if (table->max_length == 0) {
+        memset(out, table->single_symbol, out_length);
+        WACKY_STAGE_END(WACKY_STAGE_DECODE);
+        return true;
+    }
+
+    // Every byte written through `out` could alias the table, so a local
+    // copy keeps its fields in registers.
+    WackyDecodeTable local = *table;
+    WackyBitReader reader;
+    bit_reader_init(&reader, in, in_size);
+    uint8_t* end = out + out_length;
+    while (out < end) {
+        bit_reader_refill(&reader);
+        if (!decode_next_symbols(&local, &reader, &out, end)) {
+            return false;
+        }
+    }
+    WACKY_STAGE_END(WACKY_STAGE_DECODE);
+    return true;
+}
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef WACKY_FLAT_C
+#define WACKY_FLAT_C
+
+#include "wacky_codes.c"
+
+// A child reference with this bit set is a leaf holding the character in the
+// low bits; otherwise it is the index of another branch.
+#define WACKY_FLAT_LEAF 0x8000
+#define WACKY_FLAT_MAX_BRANCHES (WACKY_MAX_SYMBOLS - 1)
+
+/**
+ * A packed copy of a WackyTree. Only branches are stored, as pairs of 16-bit
+ * child references numbered breadth first from the root, so the top of the
+ * tree shares the first cache lines. A full 128-character tree takes 508
+ * bytes of child references and a full 256-byte tree 1020. Weights live in
+ * their own arrays since no traversal reads them.
+ */
+typedef struct WackyFlatTree WackyFlatTree;
+struct WackyFlatTree {
+    uint16_t children[WACKY_FLAT_MAX_BRANCHES][2];
+    uint16_t root;
+    int branch_count;
+
+    double branch_weights[WACKY_FLAT_MAX_BRANCHES];
+    double leaf_weights[WACKY_MAX_SYMBOLS];
+};
+
+static inline bool flat_is_leaf(uint16_t ref) {
+    return (ref & WACKY_FLAT_LEAF) != 0;
+}
+
+/**
+ * Given the root of a WackyTree, this function fills `flat` with the packed
+ * layout of the same tree.
+ *
+ * @return false if the tree is empty or has more than 256 leaves.
+ */
+bool flatten_wacky_tree(WackyTreeNode* tree, WackyFlatTree* flat) {
+    if (tree == NULL || flat == NULL) {
+        return false;
+    }
+    flat->branch_count = 0;
+    for (int i = 0; i < WACKY_MAX_SYMBOLS; i++) {
+        flat->leaf_weights[i] = 0;
+    }
+
+    // Breadth-first queue of branches; a branch's position in the queue is
+    // its index in `children`.
+    WackyTreeNode* queue[WACKY_FLAT_MAX_BRANCHES];
+    int queue_length = 0;
+    WackyTreeNode* pending[3] = {tree, NULL, NULL};
+    uint16_t* slots[3] = {&flat->root, NULL, NULL};
+    int pending_count = 1;
+    int head = 0;
+
+    while (true) {
+        for (int p = 0; p < pending_count; p++) {
+            WackyTreeNode* node = pending[p];
+            if (is_wacky_leaf(node)) {
+                unsigned char symbol = (unsigned char)node->val;
+                *slots[p] = WACKY_FLAT_LEAF | symbol;
+                flat->leaf_weights[symbol] = node->weight;
+            } else {
+                if (queue_length == WACKY_FLAT_MAX_BRANCHES ||
+                    node->left == NULL || node->right == NULL) {
+                    return false;
+                }
+                *slots[p] = queue_length;
+                flat->branch_weights[queue_length] = node->weight;
+                queue[queue_length++] = node;
+            }
+        }
+        if (head == queue_length) {
+            break;
+        }
+        pending[0] = queue[head]->left;
+        pending[1] = queue[head]->right;
+        slots[0] = &flat->children[head][0];
+        slots[1] = &flat->children[head][1];
+        pending_count = 2;
+        head++;
+    }
+
+    flat->branch_count = queue_length;
+    return true;
+}
+
+int flat_height_helper(WackyFlatTree* flat, uint16_t ref) {
+    if (flat_is_leaf(ref)) {
+        return 1;
+    }
+    return MAX(flat_height_helper(flat, flat->children[ref][0]),
+               flat_height_helper(flat, flat->children[ref][1])) +
+           1;
+}
+
+/**
+ * The flat-tree version of get_height().
+ */
+int flat_get_height(WackyFlatTree* flat) {
+    if (flat == NULL) {
+        return 0;
+    }
+    return flat_height_helper(flat, flat->root);
+}
+
+/**
+ * The flat-tree version of get_character(). Returns '\0' if the path runs off
+ * a leaf or ends on a branch.
+ */
+char flat_get_character(WackyFlatTree* flat, bool boolean_array[],
+                        int array_size) {
+    if (flat == NULL || boolean_array == NULL) {
+        return '\0';
+    }
+    uint16_t ref = flat->root;
+    for (int i = 0; i < array_size; i++) {
+        if (flat_is_leaf(ref)) {
+            return '\0';
+        }
+        ref = flat->children[ref][boolean_array[i]];
+    }
+    return flat_is_leaf(ref) ? (char)(ref & ~WACKY_FLAT_LEAF) : '\0';
+}
+
+/**
+ * The flat-tree version of decode_ints(). Reads the same integer array and
+ * returns the same string. `int_count` is the number of ints at `ints`,
+ * ints[0] included; nothing past them is read, and NULL is returned if
+ * ints[0] is negative or the codes after it run out first.
+ */
+char* flat_decode_ints(WackyFlatTree* flat, int* ints, size_t int_count) {
+    if (flat == NULL || ints == NULL || int_count == 0) {
+        return NULL;
+    }
+
+    int string_length = ints[0];
+    int* read_buffer = &ints[1];
+    size_t word_count = int_count - 1;
+    // Unless the root is the only leaf, every symbol takes at least one bit.
+    if (string_length < 0 ||
+        (!flat_is_leaf(flat->root) &&
+         (uint64_t)string_length > (uint64_t)word_count * WACKY_WORD_BITS)) {
+        return NULL;
+    }
+    char* output = malloc(((size_t)string_length + 1) * sizeof(char));
+    if (output == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+
+    int current_string_length = 0;
+    if (flat_is_leaf(flat->root)) {
+        memset(output, flat->root & ~WACKY_FLAT_LEAF, string_length);
+        current_string_length = string_length;
+    }
+
+    uint16_t ref = flat->root;
+    for (size_t read_buffer_idx = 0; current_string_length < string_length;
+         read_buffer_idx++) {
+        if (read_buffer_idx == word_count) {
+            free(output);
+            return NULL;
+        }
+        uint32_t value = (uint32_t)read_buffer[read_buffer_idx];
+        for (int bit_idx = 0; bit_idx < WACKY_WORD_BITS &&
+                              current_string_length < string_length;
+             bit_idx++) {
+            ref = flat->children[ref][(value >> bit_idx) & 1];
+            if (flat_is_leaf(ref)) {
+                output[current_string_length++] = ref & ~WACKY_FLAT_LEAF;
+                ref = flat->root;
+            }
+        }
+    }
+
+    output[string_length] = '\0';
+    return output;
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef WACKY_GENERATE_C
+#define WACKY_GENERATE_C
+
+#include "wacky_decode.c"
+
+/**
+ * Static codecs: C source for an encoder and decoder fixed to one code
+ * table, to be compiled into a program. The codes and the decode table are
+ * constant arrays, so nothing is built at startup, and the code length
+ * limit, root table width and mask are literals the compiler can fold. The
+ * decoder loop is generated for the table at hand: the sub-table walk is
+ * left out when every code fits in the root table, and the unknown-byte check
+ * is left out of the encoder when every byte has a code.
+ *
+ * For a name `p`, the generated source defines:
+ *
+ *   size_t p_bound(size_t length)
+ *   bool p_encode(const uint8_t* data, size_t length, uint8_t* out,
+ *                 size_t capacity, size_t* out_size)
+ *   bool p_decode(const uint8_t* in, size_t in_size, uint8_t* out,
+ *                 size_t out_length)
+ *
+ * which read and write the bit streams of encode_bytes_to_stream(), so
+ * static and runtime codecs can decode each other's output. The source only
+ * needs the standard headers.
+ *
+ * Each decode slot is packed into 32 bits:
+ *
+ *   symbols  bits 0-7 first symbol, 8-15 second symbol, 16-21 bits of the
+ *            first, 22-27 bits of both, 28-29 symbol count, 30-31 1
+ *   link     bits 0-17 sub-table offset, 18-21 sub-table width, 22-27 bits
+ *            consumed, 30-31 2
+ *
+ * and an invalid slot is 0.
+ */
+
+#define WACKY_STATIC_SYMBOLS 1u
+#define WACKY_STATIC_LINK 2u
+#define WACKY_STATIC_MAX_LINK ((1u << 18) - 1)
+
+/**
+ * Packs one decode slot as described above.
+ *
+ * @return false if a sub-table offset does not fit in 18 bits.
+ */
+bool pack_static_entry(const WackyDecodeEntry* entry, uint32_t* packed) {
+    switch (entry->type) {
+    case WACKY_ENTRY_SYMBOLS:
+        *packed = entry->symbols[0] | (uint32_t)entry->symbols[1] << 8 |
+                  (uint32_t)entry->first_bits << 16 |
+                  (uint32_t)entry->bits << 22 | (uint32_t)entry->count << 28 |
+                  WACKY_STATIC_SYMBOLS << 30;
+        return true;
+    case WACKY_ENTRY_LINK:
+        if (entry->link > WACKY_STATIC_MAX_LINK) {
+            return false;
+        }
+        *packed = entry->link | (uint32_t)entry->sub_bits << 18 |
+                  (uint32_t)entry->bits << 22 | WACKY_STATIC_LINK << 30;
+        return true;
+    default:
+        *packed = 0;
+        return true;
+    }
+}
+
+/**
+ * Writes `count` values as the body of a constant array, eight per line.
+ */
+void write_static_array(FILE* out, const uint32_t* values, size_t count,
+                        const char* format) {
+    for (size_t i = 0; i < count; i++) {
+        fprintf(out, i % 8 == 0 ? "    " : " ");
+        fprintf(out, format, values[i]);
+        fprintf(out, i % 8 == 7 || i == count - 1 ? ",\n" : ",");
+    }
+}
+
+/**
+ * Given a code table, this function writes the source of a static codec
+ * named `name` to `out`.
+ *
+ * @param out Where to write the source.
+ * @param name The prefix of every generated identifier; must be a valid C
+ * identifier.
+ * @param codes A canonical code table with no code longer than
+ * WACKY_MAX_DECODE_LENGTH bits.
+ * @param origin A line describing where the table came from, copied into
+ * the generated comment, or NULL.
+ *
+ * @return false if the table is empty or too long to decode, memory runs
+ * out, or writing fails.
+ */
+bool write_static_codec(FILE* out, const char* name, WackyCodeTable* codes,
+                        const char* origin) {
+    WackyDecodeTable table;
+    if (out == NULL || name == NULL || codes == NULL ||
+        !build_wacky_decode_table(codes, &table)) {
+        return false;
+    }
+
+    uint32_t bits[WACKY_BYTE_ALPHABET_SIZE];
+    uint32_t lengths[WACKY_BYTE_ALPHABET_SIZE];
+    bool covers_all_bytes = true;
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        covers_all_bytes &= codes->codes[i].length >= 0;
+        bits[i] = codes->codes[i].length >= 0 ? codes->codes[i].bits : 0;
+        // 255 marks a byte with no code.
+        lengths[i] = codes->codes[i].length >= 0 ? codes->codes[i].length : 255;
+    }
+    uint32_t* entries = malloc(MAX(table.entry_count, 1) * sizeof(uint32_t));
+    bool ok = entries != NULL;
+    bool has_links = false;
+    for (size_t i = 0; ok && i < table.entry_count; i++) {
+        ok = pack_static_entry(&table.entries[i], &entries[i]);
+        has_links |= table.entries[i].type == WACKY_ENTRY_LINK;
+    }
+    if (!ok) {
+        free(entries);
+        free_wacky_decode_table(&table);
+        return false;
+    }
+
+    fprintf(out,
+            "/**\n"
+            " * Static codec \"%s\", generated by write_static_codec() in\n"
+            " * wacky_generate.c. Do not edit; regenerate it instead.\n",
+            name);
+    if (origin != NULL) {
+        fprintf(out, " *\n * %s\n", origin);
+    }
+    fprintf(out,
+            " *\n"
+            " * Longest code %d bits, %zu decode slots.\n"
+            " */\n\n"
+            "#include <stdbool.h>\n"
+            "#include <stddef.h>\n"
+            "#include <stdint.h>\n\n",
+            table.max_length, table.entry_count);
+
+    fprintf(out, "static const uint32_t %s_code_bits[256] = {\n", name);
+    write_static_array(out, bits, WACKY_BYTE_ALPHABET_SIZE, "0x%08xu");
+    fprintf(out, "};\n\nstatic const uint8_t %s_code_lengths[256] = {\n", name);
+    write_static_array(out, lengths, WACKY_BYTE_ALPHABET_SIZE, "%3u");
+    if (table.max_length > 0) {
+        fprintf(out, "};\n\nstatic const uint32_t %s_decode_slots[%zu] = {\n",
+                name, table.entry_count);
+        write_static_array(out, entries, table.entry_count, "0x%08xu");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out,
+            "size_t %s_bound(size_t length) {\n"
+            "    return (length * %d + 7) / 8;\n"
+            "}\n\n",
+            name, table.max_length);
+
+    fprintf(out,
+            "bool %s_encode(\n"
+            "    const uint8_t* data, size_t length, uint8_t* out, size_t capacity,\n"
+            "    size_t* out_size) {\n"
+            "    uint8_t* start = out;\n"
+            "    uint8_t* end = out + capacity;\n"
+            "    uint64_t accumulator = 0;\n"
+            "    int pending = 0;\n"
+            "    for (size_t i = 0; i < length; i++) {\n"
+            "        int code_length = %s_code_lengths[data[i]];\n",
+            name, name);
+    if (!covers_all_bytes) {
+        fprintf(out,
+                "        if (code_length == 255) {\n"
+                "            return false;\n"
+                "        }\n");
+    }
+    fprintf(out,
+            "        accumulator |= (uint64_t)%s_code_bits[data[i]] << pending;\n"
+            "        pending += code_length;\n"
+            "        if (pending >= 32) {\n"
+            "            if (end - out < 4) {\n"
+            "                return false;\n"
+            "            }\n"
+            "            out[0] = (uint8_t)accumulator;\n"
+            "            out[1] = (uint8_t)(accumulator >> 8);\n"
+            "            out[2] = (uint8_t)(accumulator >> 16);\n"
+            "            out[3] = (uint8_t)(accumulator >> 24);\n"
+            "            out += 4;\n"
+            "            accumulator >>= 32;\n"
+            "            pending -= 32;\n"
+            "        }\n"
+            "    }\n"
+            "    for (; pending > 0; pending -= 8) {\n"
+            "        if (out == end) {\n"
+            "            return false;\n"
+            "        }\n"
+            "        *out++ = (uint8_t)accumulator;\n"
+            "        accumulator >>= 8;\n"
+            "    }\n"
+            "    *out_size = out - start;\n"
+            "    return true;\n"
+            "}\n\n",
+            name);
+
+    fprintf(out,
+            "bool %s_decode(\n"
+            "    const uint8_t* in, size_t in_size, uint8_t* out, size_t out_length) {\n",
+            name);
+    if (table.max_length == 0) {
+        // The only symbol has an empty code.
+        fprintf(out,
+                "    (void)in;\n"
+                "    (void)in_size;\n"
+                "    for (size_t i = 0; i < out_length; i++) {\n"
+                "        out[i] = %u;\n"
+                "    }\n"
+                "    return true;\n"
+                "}\n",
+                (uint8_t)table.single_symbol);
+    } else {
+        fprintf(out,
+                "    uint8_t* end = out + out_length;\n"
+                "    uint64_t accumulator = 0;\n"
+                "    int available = 0;\n"
+                "    size_t position = 0;\n"
+                "    while (out < end) {\n"
+                "        if (available < %d) {\n"
+                "            if (position + 8 <= in_size) {\n"
+                "                uint64_t word = 0;\n"
+                "                for (int b = 0; b < 8; b++) {\n"
+                "                    word |= (uint64_t)in[position + b] << (8 * b);\n"
+                "                }\n"
+                "                accumulator |= word << available;\n"
+                "                int bytes = (63 - available) / 8;\n"
+                "                position += bytes;\n"
+                "                available += bytes * 8;\n"
+                "            } else {\n"
+                "                while (available <= 56 && position < in_size) {\n"
+                "                    accumulator |= (uint64_t)in[position++] << available;\n"
+                "                    available += 8;\n"
+                "                }\n"
+                "            }\n"
+                "        }\n"
+                "        uint32_t entry = %s_decode_slots[accumulator & 0x%xu];\n",
+                table.max_length, name, (1u << table.root_bits) - 1);
+        if (has_links) {
+            fprintf(out,
+                    "        int consumed = 0;\n"
+                    "        while (entry >> 30 == 2) {\n"
+                    "            consumed += (entry >> 22) & 63;\n"
+                    "            uint64_t mask = ((uint64_t)1 << ((entry >> 18) & 15)) - 1;\n"
+                    "            size_t slot = (entry & 0x3ffffu) + ((accumulator >> consumed) & mask);\n"
+                    "            entry = %s_decode_slots[slot];\n"
+                    "        }\n"
+                    "        int used = consumed + ((entry >> 16) & 63);\n",
+                    name);
+        } else {
+            fprintf(out, "        int used = (entry >> 16) & 63;\n");
+        }
+        fprintf(out,
+                "        if (entry >> 30 != 1 || used > available) {\n"
+                "            return false;\n"
+                "        }\n"
+                "        *out++ = (uint8_t)entry;\n"
+                "        int pair_bits = (entry >> 22) & 63;\n"
+                "        if (((entry >> 28) & 3) == 2 && pair_bits <= available && out < end) {\n"
+                "            *out++ = (uint8_t)(entry >> 8);\n"
+                "            used = pair_bits;\n"
+                "        }\n"
+                "        accumulator >>= used;\n"
+                "        available -= used;\n"
+                "    }\n"
+                "    return true;\n"
+                "}\n");
+    }
+
+    free(entries);
+    free_wacky_decode_table(&table);
+    return !ferror(out);
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef WACKY_HISTOGRAM_C
+#define WACKY_HISTOGRAM_C
+
+#include <stdint.h>
+
+#include "wackman.c"
+
+#define WACKY_HISTOGRAM_LANES 8
+// Each lane sees one byte in eight, so a lane counts at most UINT32_MAX / 8
+// bytes of a block this size and its 32-bit counters cannot overflow. The
+// size itself still fits in a 32-bit size_t.
+#define WACKY_HISTOGRAM_FLUSH_BYTES \
+    ((size_t)(UINT32_MAX / 8) * WACKY_HISTOGRAM_LANES)
+
+/**
+ * Counts the lanes of one 8-byte word, one sub-histogram per byte position.
+ */
+static inline void histogram_word(uint32_t lanes[][WACKY_BYTE_ALPHABET_SIZE],
+                                  uint64_t word) {
+    lanes[0][word & 0xFF]++;
+    lanes[1][(word >> 8) & 0xFF]++;
+    lanes[2][(word >> 16) & 0xFF]++;
+    lanes[3][(word >> 24) & 0xFF]++;
+    lanes[4][(word >> 32) & 0xFF]++;
+    lanes[5][(word >> 40) & 0xFF]++;
+    lanes[6][(word >> 48) & 0xFF]++;
+    lanes[7][word >> 56]++;
+}
+
+/**
+ * Given a buffer of bytes, this function adds the number of occurrences of
+ * every byte value to `counts`.
+ *
+ * A single counter array stalls whenever the same byte repeats, since each
+ * increment has to wait for the previous store to the same slot. Here every
+ * byte position within an 8-byte word has its own sub-histogram, so runs of
+ * the same byte touch eight different counters, and the sub-histograms are
+ * summed at the end.
+ *
+ * @param counts The running totals, indexed by byte value. Not cleared.
+ * @param data The bytes to count.
+ * @param length The number of bytes at `data`.
+ */
+void compute_byte_histogram(uint64_t counts[WACKY_BYTE_ALPHABET_SIZE],
+                            const uint8_t* data, size_t length) {
+    if (data == NULL || counts == NULL) {
+        return;
+    }
+    WACKY_STAGE_BEGIN(WACKY_STAGE_HISTOGRAM);
+    WACKY_COUNT(WACKY_STAT_BYTES_HISTOGRAMMED, length);
+
+    uint32_t lanes[WACKY_HISTOGRAM_LANES][WACKY_BYTE_ALPHABET_SIZE];
+    while (length > 0) {
+        size_t block = MIN(length, WACKY_HISTOGRAM_FLUSH_BYTES);
+        memset(lanes, 0, sizeof(lanes));
+
+        size_t i = 0;
+        for (; i + 4 * sizeof(uint64_t) <= block; i += 4 * sizeof(uint64_t)) {
+            uint64_t words[4];
+            memcpy(words, &data[i], sizeof(words));
+            histogram_word(lanes, words[0]);
+            histogram_word(lanes, words[1]);
+            histogram_word(lanes, words[2]);
+            histogram_word(lanes, words[3]);
+        }
+        for (; i < block; i++) {
+            lanes[i % WACKY_HISTOGRAM_LANES][data[i]]++;
+        }
+
+        for (int c = 0; c < WACKY_BYTE_ALPHABET_SIZE; c++) {
+            uint64_t sum = 0;
+            for (int lane = 0; lane < WACKY_HISTOGRAM_LANES; lane++) {
+                sum += lanes[lane][c];
+            }
+            counts[c] += sum;
+        }
+        data += block;
+        length -= block;
+    }
+    WACKY_STAGE_END(WACKY_STAGE_HISTOGRAM);
+}
+
+/**
+ * Converts 64-bit counts into an occurrence array for the tree builders,
+ * whose sums are ints. When the total does not fit, every count is scaled
+ * down by the same power of two, and bytes that occur keep a count of at least
+ * one so they still get a code.
+ */
+void counts_to_occurrence_array(const uint64_t counts[WACKY_BYTE_ALPHABET_SIZE],
+                                int occurrence_array[WACKY_BYTE_ALPHABET_SIZE]) {
+    uint64_t total = 0;
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        total += counts[i];
+    }
+    int shift = 0;
+    while ((total >> shift) + WACKY_BYTE_ALPHABET_SIZE > (uint64_t)INT_MAX) {
+        shift++;
+    }
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        occurrence_array[i] =
+            counts[i] == 0 ? 0 : (int)MAX(counts[i] >> shift, (uint64_t)1);
+    }
+}
+
+/**
+ * The fast-path equivalent of compute_byte_occurrence_array(). Inputs with
+ * more than INT_MAX bytes are scaled as in counts_to_occurrence_array().
+ */
+void compute_fast_occurrence_array(int occurrence_array[WACKY_BYTE_ALPHABET_SIZE],
+                                   const uint8_t* data, size_t length) {
+    if (occurrence_array == NULL) {
+        return;
+    }
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    compute_byte_histogram(counts, data, length);
+    counts_to_occurrence_array(counts, occurrence_array);
+}
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef WACKY_INTERLEAVE_C
+#define WACKY_INTERLEAVE_C
+
+#include "wacky_decode.c"
+
+/**
+ * Interleaved streams: a buffer is cut into N equal segments and each segment
+ * is coded as its own bit stream. A single stream is one long dependency
+ * chain, since where a code ends is only known once it has been looked up.
+ * N streams are N independent chains, and the decoder advances all of them
+ * in the same loop so the CPU can overlap their lookups. That loop is only
+ * taken when no code is longer than WACKY_INTERLEAVE_MAX_LENGTH bits; longer
+ * codes still decode, one stream at a time.
+ *
+ * An interleaved payload is:
+ *
+ *   byte 0      the number of streams N, 1 to WACKY_MAX_INTERLEAVE_STREAMS
+ *   jump table  the sizes in bytes of streams 0 to N - 2, 32-bit
+ *               little-endian; the last stream takes the rest
+ *   streams     each one a bit stream, see encode_bytes_to_stream()
+ *
+ * For `length` symbols every stream holds ceil(length / N) of them in order,
+ * except the last, which holds what is left.
+ */
+
+#define WACKY_MAX_INTERLEAVE_STREAMS 16
+// Codes of up to this many bits decode in a single root table lookup; see
+// decode_streams_branchless(). Tables for interleaved payloads should be
+// built with it as their limit.
+#define WACKY_INTERLEAVE_MAX_LENGTH WACKY_ROOT_TABLE_BITS
+// A refill leaves at least 56 bits, which is enough for this many codes.
+#define WACKY_INTERLEAVE_SYMBOLS_PER_REFILL (56 / WACKY_INTERLEAVE_MAX_LENGTH)
+
+static inline void store_le32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (uint8_t)(value >> (i * CHAR_BIT));
+    }
+}
+
+static inline uint32_t read_le32(const uint8_t* in) {
+    return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 |
+           (uint32_t)in[3] << 24;
+}
+
+static inline size_t interleave_jump_table_size(int streams) {
+    return 1 + 4 * (size_t)(streams - 1);
+}
+
+/**
+ * Returns the largest interleaved payload `length` bytes coded in `streams`
+ * streams with codes of at most `max_length` bits can produce.
+ */
+size_t wacky_interleaved_bound(size_t length, int max_length, int streams) {
+    return interleave_jump_table_size(streams) + streams +
+           (length * (size_t)max_length + CHAR_BIT - 1) / CHAR_BIT;
+}
+
+/**
+ * Given a code table and a buffer of bytes, this function writes an
+ * interleaved payload.
+ *
+ * @param table A code table built by build_wacky_code_table().
+ * @param data The bytes to be encoded.
+ * @param length The number of bytes at `data`.
+ * @param streams The number of streams, 1 to WACKY_MAX_INTERLEAVE_STREAMS.
+ * @param out Where to write the payload.
+ * @param out_capacity The space at `out`; wacky_interleaved_bound() is always
+ * enough.
+ * @param out_size Set to the number of bytes written.
+ *
+ * @return false if a byte has no code, `out` is too small, or a stream other
+ * than the last is 4 GiB or more.
+ */
+bool encode_bytes_interleaved(WackyCodeTable* table, const uint8_t* data,
+                              size_t length, int streams, uint8_t* out,
+                              size_t out_capacity, size_t* out_size) {
+    if (table == NULL || (data == NULL && length > 0) || out == NULL ||
+        out_size == NULL || streams < 1 ||
+        streams > WACKY_MAX_INTERLEAVE_STREAMS ||
+        out_capacity < interleave_jump_table_size(streams)) {
+        return false;
+    }
+    out[0] = streams;
+    size_t position = interleave_jump_table_size(streams);
+    size_t segment = (length + streams - 1) / streams;
+
+    for (int s = 0; s < streams; s++) {
+        size_t start = MIN(s * segment, length);
+        size_t stream_size;
+        if (!encode_bytes_to_stream(table, &data[start],
+                                    MIN(segment, length - start),
+                                    &out[position], out_capacity - position,
+                                    &stream_size)) {
+            return false;
+        }
+        if (s < streams - 1) {
+            if (stream_size > UINT32_MAX) {
+                return false;
+            }
+            store_le32(&out[1 + 4 * s], stream_size);
+        }
+        position += stream_size;
+    }
+    *out_size = position;
+    return true;
+}
+
+/**
+ * The inner loop for `streams` streams whose codes all fit in the root table.
+ * Every pass refills each stream once and then decodes
+ * WACKY_INTERLEAVE_SYMBOLS_PER_REFILL symbols from each, taking the streams
+ * in turn. A symbol is one root lookup with no branch: pair entries are
+ * decoded one symbol at a time, and an invalid code only sets a flag that is
+ * checked at the end. The passes are counted up front so that every stream
+ * has 8 bytes to load and room for its symbols, which leaves nothing to check
+ * inside them either.
+ *
+ * Called with a constant `streams`, the loops over the streams unroll and
+ * their state stays in registers.
+ */
+static inline bool decode_streams_branchless(const WackyDecodeTable* table,
+                                             WackyBitReader readers[],
+                                             uint8_t* outs[], uint8_t* ends[],
+                                             const int streams) {
+    const WackyDecodeEntry* root = table->entries;
+    const uint64_t mask = ((uint64_t)1 << table->root_bits) - 1;
+    uint64_t accumulators[WACKY_MAX_INTERLEAVE_STREAMS];
+    int available[WACKY_MAX_INTERLEAVE_STREAMS];
+    size_t positions[WACKY_MAX_INTERLEAVE_STREAMS];
+    uint8_t* out[WACKY_MAX_INTERLEAVE_STREAMS];
+    for (int s = 0; s < streams; s++) {
+        accumulators[s] = readers[s].accumulator;
+        available[s] = readers[s].available;
+        positions[s] = readers[s].position;
+        out[s] = outs[s];
+    }
+
+    int invalid = 0;
+    for (;;) {
+        // A refill takes at most 7 bytes.
+        size_t passes = SIZE_MAX;
+        for (int s = 0; s < streams; s++) {
+            size_t in_left = readers[s].size - positions[s];
+            size_t out_left = ends[s] - out[s];
+            passes = in_left < sizeof(uint64_t)
+                         ? 0
+                         : MIN(passes, (in_left - sizeof(uint64_t)) / 7 + 1);
+            passes = MIN(passes, out_left / WACKY_INTERLEAVE_SYMBOLS_PER_REFILL);
+        }
+        if (passes == 0) {
+            break;
+        }
+        for (; passes > 0; passes--) {
+            for (int s = 0; s < streams; s++) {
+                accumulators[s] |= load_le64(&readers[s].in[positions[s]])
+                                   << available[s];
+                int bytes = (63 - available[s]) / CHAR_BIT;
+                positions[s] += bytes;
+                available[s] += bytes * CHAR_BIT;
+            }
+            for (int k = 0; k < WACKY_INTERLEAVE_SYMBOLS_PER_REFILL; k++) {
+                for (int s = 0; s < streams; s++) {
+                    const WackyDecodeEntry* entry =
+                        &root[accumulators[s] & mask];
+                    *out[s]++ = entry->symbols[0];
+                    invalid |= entry->type ^ WACKY_ENTRY_SYMBOLS;
+                    accumulators[s] >>= entry->first_bits;
+                    available[s] -= entry->first_bits;
+                }
+            }
+        }
+    }
+
+    for (int s = 0; s < streams; s++) {
+        readers[s].accumulator = accumulators[s];
+        readers[s].available = available[s];
+        readers[s].position = positions[s];
+        outs[s] = out[s];
+    }
+    return invalid == 0;
+}
+
+/**
+ * Decodes an interleaved payload written by encode_bytes_interleaved().
+ *
+ * @param table A decode table built by build_wacky_decode_table().
+ * @param in The payload.
+ * @param in_size The number of bytes at `in`.
+ * @param out Where to write the decoded bytes.
+ * @param out_length The number of bytes to decode.
+ *
+ * @return false if the jump table or a stream is truncated or corrupt.
+ */
+bool decode_bytes_interleaved(WackyDecodeTable* table, const uint8_t* in,
+                              size_t in_size, uint8_t* out,
+                              size_t out_length) {
+    if (table == NULL || in == NULL || in_size == 0 ||
+        (out == NULL && out_length > 0)) {
+        return false;
+    }
+    int streams = in[0];
+    size_t position = interleave_jump_table_size(streams);
+    if (streams < 1 || streams > WACKY_MAX_INTERLEAVE_STREAMS ||
+        position > in_size) {
+        return false;
+    }
+    if (table->max_length == 0) {
+        return decode_bytes_with_table(table, NULL, 0, out, out_length);
+    }
+    WACKY_STAGE_BEGIN(WACKY_STAGE_DECODE);
+    WACKY_COUNT(WACKY_STAT_SYMBOLS_DECODED, out_length);
+
+    WackyBitReader readers[WACKY_MAX_INTERLEAVE_STREAMS];
+    uint8_t* outs[WACKY_MAX_INTERLEAVE_STREAMS];
+    uint8_t* ends[WACKY_MAX_INTERLEAVE_STREAMS];
+    size_t segment = (out_length + streams - 1) / streams;
+    for (int s = 0; s < streams; s++) {
+        size_t stream_size = s < streams - 1 ? read_le32(&in[1 + 4 * s])
+                                             : in_size - position;
+        if (stream_size > in_size - position) {
+            return false;
+        }
+        bit_reader_init(&readers[s], &in[position], stream_size);
+        position += stream_size;
+        size_t start = MIN(s * segment, out_length);
+        outs[s] = &out[start];
+        ends[s] = &out[start + MIN(segment, out_length - start)];
+    }
+
+    bool ok = true;
+    if (table->max_length <= WACKY_INTERLEAVE_MAX_LENGTH) {
+        switch (streams) {
+        case 2:
+            ok = decode_streams_branchless(table, readers, outs, ends, 2);
+            break;
+        case 4:
+            ok = decode_streams_branchless(table, readers, outs, ends, 4);
+            break;
+        case 8:
+            ok = decode_streams_branchless(table, readers, outs, ends, 8);
+            break;
+        default:
+            ok = decode_streams_branchless(table, readers, outs, ends, streams);
+            break;
+        }
+    }
+    // The streams end at different times, and longer codes take this path
+    // alone; finish each stream on its own.
+    for (int s = 0; ok && s < streams; s++) {
+        while (ok && outs[s] < ends[s]) {
+            bit_reader_refill(&readers[s]);
+            ok = decode_next_symbols(table, &readers[s], &outs[s], ends[s]);
+        }
+    }
+    if (ok) {
+        WACKY_STAGE_END(WACKY_STAGE_DECODE);
+    }
+    return ok;
+}
+
+#endif
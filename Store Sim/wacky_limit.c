@@ -0,0 +1,292 @@
+#ifndef WACKY_LIMIT_C
+#define WACKY_LIMIT_C
+
+#include "wacky_build.c"
+#include "wacky_canonical.c"
+
+/**
+ * Length-limited codes. A Huffman tree can be as deep as the alphabet is
+ * large (Fibonacci-like counts give one extra level per symbol), which is too
+ * deep for single-lookup decode tables. The package-merge algorithm finds the
+ * optimal code whose lengths are all at most a given limit.
+ */
+
+/**
+ * Computes optimal code lengths of at most `max_length` bits.
+ *
+ * Package-merge works on one list per allowed length. The deepest list holds
+ * the symbols; each shallower list is the symbols merged by weight with
+ * pairs ("packages") of the list below it. Taking the 2n - 2 cheapest items
+ * of the top list and expanding packages back down gives every symbol a code
+ * length equal to the number of lists it was taken from.
+ *
+ * @param weights The symbol counts in ascending order. Their sum times
+ * `max_length` must fit in 64 bits, since that bounds any package.
+ * @param count The number of symbols.
+ * @param max_length The longest code allowed.
+ * @param lengths Set to the code length of each symbol, non-increasing since
+ * the weights ascend.
+ *
+ * @return false if `count` symbols do not fit in codes of `max_length` bits.
+ */
+bool limit_code_lengths(const uint64_t weights[], int count, int max_length,
+                        int lengths[]) {
+    if (weights == NULL || lengths == NULL || count <= 0 ||
+        count > WACKY_MAX_SYMBOLS || max_length > WACKY_MAX_CODE_LENGTH) {
+        return false;
+    }
+    if (count == 1) {
+        // A lone symbol is the root of its tree and needs no bits.
+        lengths[0] = 0;
+        return true;
+    }
+    if (max_length < 1 ||
+        (max_length < 63 && (uint64_t)count > (uint64_t)1 << max_length)) {
+        return false;
+    }
+    // No code can be longer than count - 1 bits anyway.
+    max_length = MIN(max_length, count - 1);
+
+    // is_leaf[level][k] tells whether item k of that level's list is a symbol
+    // or a package; level 0 is the top list.
+    uint8_t is_leaf[WACKY_MAX_CODE_LENGTH][2 * WACKY_MAX_SYMBOLS];
+    uint64_t previous[2 * WACKY_MAX_SYMBOLS];
+    uint64_t current[2 * WACKY_MAX_SYMBOLS];
+    int previous_length = count;
+    for (int k = 0; k < count; k++) {
+        previous[k] = weights[k];
+        is_leaf[max_length - 1][k] = 1;
+    }
+
+    for (int level = max_length - 2; level >= 0; level--) {
+        int packages = previous_length / 2;
+        int leaf = 0, package = 0, length = 0;
+        while (leaf < count || package < packages) {
+            uint64_t package_weight =
+                package < packages
+                    ? previous[2 * package] + previous[2 * package + 1]
+                    : 0;
+            // Symbols go first on ties, which keeps codes short when it is
+            // free to do so.
+            if (package == packages ||
+                (leaf < count && weights[leaf] <= package_weight)) {
+                current[length] = weights[leaf++];
+                is_leaf[level][length++] = 1;
+            } else {
+                current[length] = package_weight;
+                is_leaf[level][length++] = 0;
+                package++;
+            }
+        }
+        memcpy(previous, current, length * sizeof(uint64_t));
+        previous_length = length;
+    }
+
+    for (int k = 0; k < count; k++) {
+        lengths[k] = 0;
+    }
+    int taken = 2 * count - 2;
+    for (int level = 0; level < max_length && taken > 0; level++) {
+        int leaves = 0;
+        for (int k = 0; k < taken; k++) {
+            leaves += is_leaf[level][k];
+        }
+        // The symbols in a list keep their order, so the ones taken are
+        // always the first `leaves`.
+        for (int k = 0; k < leaves; k++) {
+            lengths[k]++;
+        }
+        taken = 2 * (taken - leaves);
+    }
+    return true;
+}
+
+/**
+ * Builds the tree for a set of code lengths. Working up from the deepest
+ * level, the nodes at each depth are paired off into the branches of the
+ * depth above.
+ *
+ * @param arena Where to allocate the branches, or NULL to use malloc.
+ * @param leaves The leaf nodes, longest code first.
+ * @param lengths The code length of each leaf, as from limit_code_lengths().
+ * @param count The number of leaves.
+ *
+ * @return The root, or NULL if the lengths do not form a complete code or a
+ * branch cannot be allocated. Either way the leaves are freed when they were
+ * malloc'd.
+ */
+WackyTreeNode* build_wacky_tree_from_lengths(WackyArena* arena,
+                                             WackyTreeNode* leaves[],
+                                             int lengths[], int count) {
+    if (count == 1) {
+        return leaves[0];
+    }
+    WackyTreeNode* level[WACKY_MAX_SYMBOLS];
+    int level_size = 0;
+    int next_leaf = 0;
+    for (int depth = lengths[0]; depth > 0; depth--) {
+        // Pair off the nodes one level down, then add this level's leaves.
+        WackyTreeNode* branches[WACKY_MAX_SYMBOLS];
+        int branch_count = level_size / 2;
+        if (level_size % 2 != 0) {
+            discard_wacky_trees(arena, level, level_size);
+            discard_wacky_trees(arena, &leaves[next_leaf], count - next_leaf);
+            return NULL;
+        }
+        for (int i = 0; i < branch_count; i++) {
+            branches[i] =
+                arena_branch_node(arena, level[2 * i], level[2 * i + 1]);
+            if (branches[i] == NULL) {
+                // The branches made so far hold level[0 .. 2i - 1].
+                discard_wacky_trees(arena, branches, i);
+                discard_wacky_trees(arena, &level[2 * i], level_size - 2 * i);
+                discard_wacky_trees(arena, &leaves[next_leaf],
+                                    count - next_leaf);
+                return NULL;
+            }
+        }
+        level_size = 0;
+        while (next_leaf < count && lengths[next_leaf] == depth) {
+            level[level_size++] = leaves[next_leaf++];
+        }
+        for (int i = 0; i < branch_count; i++) {
+            level[level_size++] = branches[i];
+        }
+    }
+    WackyTreeNode* root = NULL;
+    if (level_size == 2 && next_leaf == count) {
+        root = arena_branch_node(arena, level[0], level[1]);
+    }
+    if (root == NULL) {
+        discard_wacky_trees(arena, level, level_size);
+        discard_wacky_trees(arena, &leaves[next_leaf], count - next_leaf);
+    }
+    return root;
+}
+
+/**
+ * The length-limited counterpart of merge_wacky_list_in(): takes the sorted
+ * list from create_wacky_list_in() and returns a tree with no leaf deeper than
+ * `max_length`. Leaves are kept as they are; branch counts and weights are the
+ * sums below them.
+ *
+ * @param arena Where to allocate the tree, or NULL to use malloc.
+ * @param linked_list The list from create_wacky_list_in().
+ * @param max_length The deepest a leaf may be, at least log2 of the number of
+ * characters.
+ *
+ * @return The root of the new tree, or NULL if `max_length` is too small, in
+ * which case the list is left as it was.
+ */
+WackyTreeNode* merge_wacky_list_limited_in(WackyArena* arena,
+                                           WackyLinkedNode* linked_list,
+                                           int max_length) {
+    WackyTreeNode* leaves[WACKY_MAX_SYMBOLS];
+    uint64_t weights[WACKY_MAX_SYMBOLS];
+    int lengths[WACKY_MAX_SYMBOLS];
+    int count = 0;
+    for (WackyLinkedNode* node = linked_list; node != NULL; node = node->next) {
+        if (count == WACKY_MAX_SYMBOLS) {
+            return NULL;
+        }
+        leaves[count] = node->val;
+        weights[count++] = node->val->count;
+    }
+    if (!limit_code_lengths(weights, count, max_length, lengths)) {
+        return NULL;
+    }
+
+    while (linked_list != NULL) {
+        WackyLinkedNode* next = linked_list->next;
+        release_linked_node(arena, linked_list);
+        linked_list = next;
+    }
+    return build_wacky_tree_from_lengths(arena, leaves, lengths, count);
+}
+
+WackyTreeNode* merge_wacky_list_limited(WackyLinkedNode* linked_list,
+                                        int max_length) {
+    return merge_wacky_list_limited_in(NULL, linked_list, max_length);
+}
+
+/**
+ * Replaces the codes in `table` with the optimal canonical codes of at most
+ * `max_length` bits for the given byte counts. Does nothing if the table
+ * already fits.
+ *
+ * @return false if the bytes that occur do not fit in `max_length` bits.
+ */
+bool limit_wacky_code_table(WackyCodeTable* table,
+                            const uint64_t counts[WACKY_BYTE_ALPHABET_SIZE],
+                            int max_length) {
+    if (table == NULL || counts == NULL) {
+        return false;
+    }
+    if (table->max_length <= max_length) {
+        return true;
+    }
+
+    // Insertion sort of the occurring bytes by (count, byte).
+    int symbols[WACKY_BYTE_ALPHABET_SIZE];
+    int count = 0;
+    for (int c = 0; c < WACKY_BYTE_ALPHABET_SIZE; c++) {
+        if (counts[c] == 0) {
+            continue;
+        }
+        int k = count++;
+        while (k > 0 && counts[symbols[k - 1]] > counts[c]) {
+            symbols[k] = symbols[k - 1];
+            k--;
+        }
+        symbols[k] = c;
+    }
+
+    uint64_t weights[WACKY_BYTE_ALPHABET_SIZE];
+    int lengths[WACKY_BYTE_ALPHABET_SIZE];
+    for (int k = 0; k < count; k++) {
+        weights[k] = counts[symbols[k]];
+    }
+    if (!limit_code_lengths(weights, count, max_length, lengths)) {
+        return false;
+    }
+    for (int c = 0; c < WACKY_MAX_SYMBOLS; c++) {
+        table->codes[c].bits = 0;
+        table->codes[c].length = -1;
+    }
+    for (int k = 0; k < count; k++) {
+        table->codes[symbols[k]].length = lengths[k];
+    }
+    return canonicalize_wacky_code_table(table);
+}
+
+/**
+ * Builds the canonical code table for a byte histogram, with no code longer
+ * than `max_length` bits.
+ *
+ * @return false if no byte occurs, the bytes do not fit in `max_length` bits,
+ * or memory runs out.
+ */
+bool build_canonical_byte_table(const uint64_t counts[WACKY_BYTE_ALPHABET_SIZE],
+                                int max_length, WackyCodeTable* table) {
+    WackyArena* arena = new_wacky_arena(WACKY_BYTE_ALPHABET_SIZE);
+    if (arena == NULL) {
+        return false;
+    }
+    WackyTreeNode* tree = build_wacky_tree_from_counts(arena, counts,
+                                                       WACKY_BYTE_ALPHABET_SIZE);
+    bool built = tree != NULL;
+    if (built && !build_wacky_code_table(tree, table)) {
+        // Deeper than 64 bits; limiting rebuilds the lengths from the counts.
+        table->max_length = INT_MAX;
+    }
+    free_wacky_arena(arena);
+    if (!built || !limit_wacky_code_table(table, counts, max_length) ||
+        !canonicalize_wacky_code_table(table)) {
+        return false;
+    }
+    WACKY_STAT(wacky_stats_add_model(counts, WACKY_BYTE_ALPHABET_SIZE,
+                                     count_encoded_bits(table, counts)));
+    return true;
+}
+
+#endif
@@ -0,0 +1,409 @@
+#ifndef WACKY_ORDER1_C
+#define WACKY_ORDER1_C
+
+#include "wacky_container.c"
+
+/**
+ * Order-1 mode: every byte is coded with a table chosen by the byte before
+ * it (its context), so text, where each letter strongly predicts the next,
+ * codes in fewer bits than with one table for the whole input. The first
+ * byte has context 0.
+ *
+ * A context's own table costs a header, which sparse contexts do not earn
+ * back, so they share one table built from their combined counts instead.
+ * The container starts like the one in wacky_container.c, with
+ * WACKY_CONTAINER_ORDER1 set in the flags:
+ *
+ *   bytes 0-13  magic, version, flags, total symbol count
+ *   32 bytes    bitmap, one bit per context, set if it has its own table
+ *   byte        1 if the shared table follows, 0 if every context that
+ *               occurs has its own table
+ *   headers     the code lengths of the shared table and then of each
+ *               context in the bitmap in order, see write_wacky_header()
+ *   8 bytes     payload size in bytes, 64-bit little-endian
+ *   payload     a bit stream, see encode_bytes_to_stream(), coding each
+ *               byte with the table of its context
+ *
+ * The bitmap and flag byte are absent when there are no symbols.
+ */
+
+#define WACKY_ORDER1_CONTEXTS WACKY_BYTE_ALPHABET_SIZE
+// Index of the shared table among the tables of a model.
+#define WACKY_ORDER1_SHARED WACKY_ORDER1_CONTEXTS
+#define WACKY_ORDER1_BITMAP_SIZE (WACKY_ORDER1_CONTEXTS / CHAR_BIT)
+
+/**
+ * The tables of every context. `table_of` maps each context to its own
+ * table or to WACKY_ORDER1_SHARED, so a coder finds its table with one
+ * lookup per symbol.
+ */
+typedef struct WackyOrder1Model WackyOrder1Model;
+struct WackyOrder1Model {
+    WackyCodeTable tables[WACKY_ORDER1_CONTEXTS + 1];
+    uint16_t table_of[WACKY_ORDER1_CONTEXTS];
+    bool has_shared;
+};
+
+/**
+ * Given a buffer of bytes, this function adds the number of times every byte
+ * follows every other byte to `counts`, indexed by context and then by byte.
+ * The first byte is counted in context 0.
+ */
+void compute_order1_histogram(
+    const uint8_t* data, size_t length,
+    uint64_t counts[WACKY_ORDER1_CONTEXTS][WACKY_BYTE_ALPHABET_SIZE]) {
+    if (data == NULL || counts == NULL) {
+        return;
+    }
+    WACKY_STAGE_BEGIN(WACKY_STAGE_HISTOGRAM);
+    WACKY_COUNT(WACKY_STAT_BYTES_HISTOGRAMMED, length);
+    uint8_t context = 0;
+    for (size_t i = 0; i < length; i++) {
+        counts[context][data[i]]++;
+        context = data[i];
+    }
+    WACKY_STAGE_END(WACKY_STAGE_HISTOGRAM);
+}
+
+/**
+ * Returns the size of the header write_wacky_header() writes for `table`.
+ */
+size_t wacky_header_size(WackyCodeTable* table) {
+    uint8_t header[WACKY_MAX_HEADER_SIZE];
+    return write_wacky_header(table, header, sizeof(header));
+}
+
+/**
+ * Builds the tables for an order-1 histogram. A context gets its own table
+ * when that saves more bits than its header costs, measured against one
+ * table for the whole input; the rest share a table built from their
+ * combined counts.
+ *
+ * @return false if no byte occurs or memory runs out.
+ */
+bool build_order1_model(
+    const uint64_t counts[WACKY_ORDER1_CONTEXTS][WACKY_BYTE_ALPHABET_SIZE],
+    WackyOrder1Model* model) {
+    uint64_t totals[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    for (int c = 0; c < WACKY_ORDER1_CONTEXTS; c++) {
+        for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+            totals[i] += counts[c][i];
+        }
+    }
+    WackyCodeTable* order0 = &model->tables[WACKY_ORDER1_SHARED];
+    if (!build_canonical_byte_table(totals, WACKY_MAX_DECODE_LENGTH, order0)) {
+        return false;
+    }
+
+    uint64_t shared[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    model->has_shared = false;
+    for (int c = 0; c < WACKY_ORDER1_CONTEXTS; c++) {
+        model->table_of[c] = WACKY_ORDER1_SHARED;
+        uint64_t occurrences = 0;
+        for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+            occurrences += counts[c][i];
+        }
+        if (occurrences == 0) {
+            continue;
+        }
+        uint64_t shared_bits = count_encoded_bits(order0, counts[c]);
+        WackyCodeTable* own = &model->tables[c];
+        if (!build_canonical_byte_table(counts[c], WACKY_MAX_DECODE_LENGTH,
+                                        own)) {
+            return false;
+        }
+        uint64_t own_bits =
+            count_encoded_bits(own, counts[c]) + wacky_header_size(own) * CHAR_BIT;
+        if (own_bits < shared_bits) {
+            model->table_of[c] = c;
+            continue;
+        }
+        model->has_shared = true;
+        for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+            shared[i] += counts[c][i];
+        }
+    }
+    return !model->has_shared ||
+           build_canonical_byte_table(shared, WACKY_MAX_DECODE_LENGTH, order0);
+}
+
+/**
+ * Given the tables of a model and a buffer of bytes, this function writes the
+ * order-1 bit stream. The codes of all tables are first laid out in one flat
+ * array indexed by context and byte, so each symbol costs one load.
+ *
+ * @param out_capacity The space at `out`; the sum of count_encoded_bits()
+ * over all contexts, in bytes, is exactly enough.
+ *
+ * @return false if a byte has no code, `out` is too small or memory runs
+ * out.
+ */
+bool encode_order1_stream(WackyOrder1Model* model, const uint8_t* data,
+                          size_t length, uint8_t* out, size_t out_capacity,
+                          size_t* out_size) {
+    WackyCode* codes =
+        malloc(sizeof(WackyCode) * WACKY_ORDER1_CONTEXTS * WACKY_BYTE_ALPHABET_SIZE);
+    if (codes == NULL) {
+        return false;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    WACKY_STAGE_BEGIN(WACKY_STAGE_ENCODE);
+    for (int c = 0; c < WACKY_ORDER1_CONTEXTS; c++) {
+        memcpy(&codes[c * WACKY_BYTE_ALPHABET_SIZE],
+               model->tables[model->table_of[c]].codes,
+               sizeof(WackyCode) * WACKY_BYTE_ALPHABET_SIZE);
+    }
+
+    WackyBitWriter writer;
+    bit_writer_init(&writer, out, out_capacity);
+    size_t context = 0;
+    for (size_t i = 0; i < length; i++) {
+        WackyCode code = codes[context * WACKY_BYTE_ALPHABET_SIZE + data[i]];
+        if (code.length < 0 || !bit_writer_put(&writer, code.bits, code.length)) {
+            free(codes);
+            return false;
+        }
+        context = data[i];
+    }
+    free(codes);
+    if (!bit_writer_finish(&writer)) {
+        return false;
+    }
+    *out_size = writer.out - out;
+    WACKY_STAGE_END(WACKY_STAGE_ENCODE);
+    WACKY_COUNT(WACKY_STAT_SYMBOLS_ENCODED, length);
+    return true;
+}
+
+/**
+ * Writes the container for `data`, given its order-1 histogram, into a new
+ * buffer of exactly the right size.
+ *
+ * @return The container, or NULL if memory runs out.
+ */
+uint8_t* write_order1_container(
+    const uint64_t counts[WACKY_ORDER1_CONTEXTS][WACKY_BYTE_ALPHABET_SIZE],
+    WackyOrder1Model* model, const uint8_t* data, size_t length,
+    size_t* out_size) {
+    size_t capacity = WACKY_CONTAINER_PREFIX_SIZE + 8;
+    if (length > 0) {
+        if (!build_order1_model(counts, model)) {
+            return NULL;
+        }
+        capacity += WACKY_ORDER1_BITMAP_SIZE + 1;
+        if (model->has_shared) {
+            capacity += wacky_header_size(&model->tables[WACKY_ORDER1_SHARED]);
+        }
+        uint64_t bits = 0;
+        for (int c = 0; c < WACKY_ORDER1_CONTEXTS; c++) {
+            WackyCodeTable* table = &model->tables[model->table_of[c]];
+            bits += count_encoded_bits(table, counts[c]);
+            if (model->table_of[c] == c) {
+                capacity += wacky_header_size(table);
+            }
+        }
+        capacity += (bits + CHAR_BIT - 1) / CHAR_BIT;
+    }
+    uint8_t* out = malloc(capacity);
+    if (out == NULL) {
+        return NULL;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+
+    memcpy(out, WACKY_CONTAINER_MAGIC, WACKY_CONTAINER_MAGIC_SIZE);
+    out[4] = WACKY_CONTAINER_VERSION;
+    out[5] = WACKY_CONTAINER_ORDER1;
+    store_le64(&out[6], length);
+    size_t position = WACKY_CONTAINER_PREFIX_SIZE;
+    size_t payload_size = 0;
+    if (length > 0) {
+        uint8_t* bitmap = &out[position];
+        memset(bitmap, 0, WACKY_ORDER1_BITMAP_SIZE);
+        out[position + WACKY_ORDER1_BITMAP_SIZE] = model->has_shared;
+        position += WACKY_ORDER1_BITMAP_SIZE + 1;
+        if (model->has_shared) {
+            position += write_wacky_header(&model->tables[WACKY_ORDER1_SHARED],
+                                           &out[position], capacity - position);
+        }
+        for (int c = 0; c < WACKY_ORDER1_CONTEXTS; c++) {
+            if (model->table_of[c] == c) {
+                bitmap[c / CHAR_BIT] |= 1 << (c % CHAR_BIT);
+                position += write_wacky_header(&model->tables[c], &out[position],
+                                               capacity - position);
+            }
+        }
+        if (!encode_order1_stream(model, data, length, &out[position + 8],
+                                  capacity - position - 8, &payload_size)) {
+            free(out);
+            return NULL;
+        }
+    }
+    store_le64(&out[position], payload_size);
+    *out_size = position + 8 + payload_size;
+    return out;
+}
+
+/**
+ * Given a buffer of bytes, this function builds an order-1 model for it and
+ * returns it as a container.
+ *
+ * @param data The bytes to be encoded.
+ * @param length The number of bytes at `data`.
+ * @param out_size Set to the size of the returned container.
+ *
+ * @return A new container the caller must free, or NULL if memory runs out.
+ */
+uint8_t* wacky_compress_order1(const uint8_t* data, size_t length,
+                               size_t* out_size) {
+    if ((data == NULL && length > 0) || out_size == NULL) {
+        return NULL;
+    }
+    // Half a megabyte of counts and a megabyte of tables are too much for
+    // the stack.
+    uint64_t(*counts)[WACKY_BYTE_ALPHABET_SIZE] =
+        calloc(WACKY_ORDER1_CONTEXTS, sizeof(*counts));
+    WackyOrder1Model* model = malloc(sizeof(WackyOrder1Model));
+    uint8_t* out = NULL;
+    if (counts != NULL && model != NULL) {
+        WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 2);
+        compute_order1_histogram(data, length, counts);
+        out = write_order1_container(counts, model, data, length, out_size);
+    }
+    free(counts);
+    free(model);
+    return out;
+}
+
+/**
+ * Decodes an order-1 bit stream, switching decode tables by the last byte
+ * decoded. Paired entries are not used, since the second symbol of a pair
+ * belongs to a different context.
+ *
+ * @param tables The decode table of each context.
+ *
+ * @return false if the stream is truncated or holds an invalid code.
+ */
+bool decode_order1_stream(WackyDecodeTable* tables[WACKY_ORDER1_CONTEXTS],
+                          const uint8_t* in, size_t in_size, uint8_t* out,
+                          size_t out_length) {
+    WACKY_STAGE_BEGIN(WACKY_STAGE_DECODE);
+    WACKY_COUNT(WACKY_STAT_SYMBOLS_DECODED, out_length);
+    WackyBitReader reader;
+    bit_reader_init(&reader, in, in_size);
+    uint8_t context = 0;
+    for (uint8_t* end = out + out_length; out < end; out++) {
+        WackyDecodeTable* table = tables[context];
+        if (table == NULL) {
+            return false;
+        }
+        if (table->max_length == 0) {
+            *out = context = table->single_symbol;
+            continue;
+        }
+        bit_reader_refill(&reader);
+        int consumed;
+        WackyDecodeEntry* entry =
+            lookup_decode_entry(table, reader.accumulator, &consumed);
+        int used = consumed + entry->first_bits;
+        if (entry->type != WACKY_ENTRY_SYMBOLS || used > reader.available) {
+            return false;
+        }
+        *out = context = entry->symbols[0];
+        reader.accumulator >>= used;
+        reader.available -= used;
+    }
+    WACKY_STAGE_END(WACKY_STAGE_DECODE);
+    return true;
+}
+
+/**
+ * Decodes a container written by wacky_compress_order1().
+ *
+ * @param in The container bytes.
+ * @param size The number of bytes at `in`.
+ * @param out_length Set to the number of decoded bytes.
+ *
+ * @return A new buffer the caller must free, or NULL if the container is
+ * corrupt.
+ */
+uint8_t* wacky_decompress_order1(const uint8_t* in, size_t size,
+                                 size_t* out_length) {
+    size_t position = WACKY_CONTAINER_PREFIX_SIZE;
+    if (in == NULL || out_length == NULL || size < position + 8 ||
+        memcmp(in, WACKY_CONTAINER_MAGIC, WACKY_CONTAINER_MAGIC_SIZE) != 0 ||
+        in[4] != WACKY_CONTAINER_VERSION || in[5] != WACKY_CONTAINER_ORDER1) {
+        return NULL;
+    }
+    uint64_t length = read_le64(&in[6]);
+    if (length > SIZE_MAX - 1) {
+        return NULL;
+    }
+
+    WackyDecodeTable decode[WACKY_ORDER1_CONTEXTS + 1];
+    WackyDecodeTable* by_context[WACKY_ORDER1_CONTEXTS] = {NULL};
+    int built = 0;
+    uint8_t* out = NULL;
+    bool ok = true;
+    if (length > 0) {
+        ok = size - position >= WACKY_ORDER1_BITMAP_SIZE + 1 &&
+             in[position + WACKY_ORDER1_BITMAP_SIZE] <= 1;
+        const uint8_t* bitmap = &in[position];
+        bool has_shared = ok && in[position + WACKY_ORDER1_BITMAP_SIZE] == 1;
+        position += WACKY_ORDER1_BITMAP_SIZE + 1;
+        for (int t = has_shared ? -1 : 0; ok && t < WACKY_ORDER1_CONTEXTS; t++) {
+            if (t >= 0 && !((bitmap[t / CHAR_BIT] >> (t % CHAR_BIT)) & 1)) {
+                continue;
+            }
+            WackyCodeTable codes;
+            size_t header_size =
+                read_wacky_header(&in[position], size - position, &codes);
+            ok = header_size > 0 && build_wacky_decode_table(&codes, &decode[built]);
+            if (!ok) {
+                break;
+            }
+            position += header_size;
+            if (t < 0) {
+                for (int c = 0; c < WACKY_ORDER1_CONTEXTS; c++) {
+                    by_context[c] = &decode[built];
+                }
+            } else {
+                by_context[t] = &decode[built];
+            }
+            built++;
+        }
+    }
+
+    uint64_t payload_size = 0;
+    if (ok && size - position >= 8) {
+        payload_size = read_le64(&in[position]);
+        position += 8;
+    } else {
+        ok = false;
+    }
+    int min_length = WACKY_MAX_CODE_LENGTH;
+    for (int t = 0; t < built; t++) {
+        min_length = MIN(min_length, decode[t].min_length);
+    }
+    if (ok && payload_size <= size - position &&
+        wacky_payload_can_hold(payload_size, length, min_length)) {
+        out = malloc(MAX(length, 1));
+    }
+    if (out != NULL) {
+        WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+        if (!decode_order1_stream(by_context, &in[position], payload_size, out,
+                                  length)) {
+            free(out);
+            out = NULL;
+        }
+    }
+
+    for (int t = 0; t < built; t++) {
+        free_wacky_decode_table(&decode[t]);
+    }
+    if (out != NULL) {
+        *out_length = length;
+    }
+    return out;
+}
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef WACKY_PARALLEL_C
+#define WACKY_PARALLEL_C
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "wacky_build.c"
+#include "wacky_decode.c"
+#include "wacky_histogram.c"
+#include "wacky_limit.c"
+
+#define WACKY_DEFAULT_CHUNK_SIZE ((size_t)1 << 20)
+#define WACKY_MAX_THREADS 256
+
+/**
+ * A buffer encoded as independent chunks with one shared code table.
+ *
+ * Chunk i covers input bytes [i * chunk_size, (i + 1) * chunk_size) and its
+ * bit stream (see encode_bytes_to_stream()) occupies payload bytes
+ * [chunk_offsets[i], chunk_offsets[i + 1]). Every chunk starts on a byte
+ * boundary, so chunks can be decoded in any order and on any thread.
+ */
+typedef struct WackyParallelEncoding WackyParallelEncoding;
+struct WackyParallelEncoding {
+    WackyCodeTable codes;
+    uint64_t input_length;
+    size_t chunk_size;
+    size_t chunk_count;
+    size_t* chunk_offsets;
+    uint8_t* payload;
+    size_t payload_size;
+};
+
+/**
+ * Shared state for one parallel job. Workers claim chunks from
+ * `next_chunk` until there are none left.
+ */
+typedef struct WackyParallelJob WackyParallelJob;
+struct WackyParallelJob {
+    const uint8_t* input;
+    uint8_t* output;
+    WackyParallelEncoding* encoding;
+    WackyDecodeTable* decode_table;
+    uint64_t (*chunk_counts)[WACKY_BYTE_ALPHABET_SIZE];
+    atomic_size_t next_chunk;
+    atomic_bool failed;
+};
+
+/**
+ * Returns `thread_count`, or the number of online processors if it is 0.
+ */
+int resolve_thread_count(int thread_count) {
+    if (thread_count <= 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = processors > 0 ? (int)processors : 1;
+    }
+    return MIN(thread_count, WACKY_MAX_THREADS);
+}
+
+/**
+ * Runs `worker` on `thread_count` threads (the calling thread included) and
+ * waits for all of them.
+ */
+void run_parallel_job(void* (*worker)(void*), WackyParallelJob* job,
+                      int thread_count) {
+    atomic_store(&job->next_chunk, 0);
+    pthread_t threads[WACKY_MAX_THREADS];
+    int started = 0;
+    for (int i = 1; i < thread_count; i++) {
+        if (pthread_create(&threads[started], NULL, worker, job) == 0) {
+            started++;
+        }
+    }
+    worker(job);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+static inline size_t chunk_length(WackyParallelEncoding* encoding,
+                                   size_t chunk) {
+    size_t start = chunk * encoding->chunk_size;
+    return MIN(encoding->chunk_size, encoding->input_length - start);
+}
+
+void* histogram_worker(void* argument) {
+    WackyParallelJob* job = argument;
+    WackyParallelEncoding* encoding = job->encoding;
+    size_t chunk;
+    while ((chunk = atomic_fetch_add(&job->next_chunk, 1)) <
+           encoding->chunk_count) {
+        compute_byte_histogram(job->chunk_counts[chunk],
+                               &job->input[chunk * encoding->chunk_size],
+                               chunk_length(encoding, chunk));
+    }
+    return NULL;
+}
+
+void* encode_worker(void* argument) {
+    WackyParallelJob* job = argument;
+    WackyParallelEncoding* encoding = job->encoding;
+    size_t chunk;
+    while ((chunk = atomic_fetch_add(&job->next_chunk, 1)) <
+           encoding->chunk_count) {
+        size_t offset = encoding->chunk_offsets[chunk];
+        size_t written;
+        if (!encode_bytes_to_stream(
+                &encoding->codes, &job->input[chunk * encoding->chunk_size],
+                chunk_length(encoding, chunk), &encoding->payload[offset],
+                encoding->chunk_offsets[chunk + 1] - offset, &written)) {
+            atomic_store(&job->failed, true);
+        }
+    }
+    return NULL;
+}
+
+void* decode_worker(void* argument) {
+    WackyParallelJob* job = argument;
+    WackyParallelEncoding* encoding = job->encoding;
+    size_t chunk;
+    while ((chunk = atomic_fetch_add(&job->next_chunk, 1)) <
+           encoding->chunk_count) {
+        size_t offset = encoding->chunk_offsets[chunk];
+        if (!decode_bytes_with_table(
+                job->decode_table, &encoding->payload[offset],
+                encoding->chunk_offsets[chunk + 1] - offset,
+                &job->output[chunk * encoding->chunk_size],
+                chunk_length(encoding, chunk))) {
+            atomic_store(&job->failed, true);
+        }
+    }
+    return NULL;
+}
+
+void free_wacky_parallel_encoding(WackyParallelEncoding* encoding) {
+    if (encoding == NULL) {
+        return;
+    }
+    free(encoding->chunk_offsets);
+    free(encoding->payload);
+    encoding->chunk_offsets = NULL;
+    encoding->payload = NULL;
+}
+
+/**
+ * Given a buffer of bytes, this function compresses it on several threads.
+ * The chunks are histogrammed in parallel, the counts are summed into one
+ * tree, and then the chunks are encoded in parallel straight into their final
+ * place in the payload, since each chunk's size follows from its histogram.
+ *
+ * @param data The bytes to be encoded.
+ * @param length The number of bytes at `data`.
+ * @param chunk_size Input bytes per chunk, or 0 for WACKY_DEFAULT_CHUNK_SIZE.
+ * @param thread_count The number of threads to use, or 0 for one per core.
+ * @param encoding The result. Release it with free_wacky_parallel_encoding().
+ *
+ * @return false if the input is empty or memory runs out.
+ */
+bool wacky_parallel_encode(const uint8_t* data, size_t length,
+                           size_t chunk_size, int thread_count,
+                           WackyParallelEncoding* encoding) {
+    if (data == NULL || length == 0 || encoding == NULL) {
+        return false;
+    }
+    thread_count = resolve_thread_count(thread_count);
+    encoding->input_length = length;
+    encoding->chunk_size = chunk_size > 0 ? chunk_size : WACKY_DEFAULT_CHUNK_SIZE;
+    encoding->chunk_count =
+        (length + encoding->chunk_size - 1) / encoding->chunk_size;
+    encoding->payload = NULL;
+    encoding->payload_size = 0;
+    encoding->chunk_offsets =
+        malloc((encoding->chunk_count + 1) * sizeof(size_t));
+
+    WackyParallelJob job = {.input = data, .encoding = encoding};
+    job.chunk_counts = calloc(encoding->chunk_count, sizeof(*job.chunk_counts));
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 2);
+    atomic_init(&job.failed, false);
+    if (encoding->chunk_offsets == NULL || job.chunk_counts == NULL) {
+        free(job.chunk_counts);
+        free_wacky_parallel_encoding(encoding);
+        return false;
+    }
+
+    run_parallel_job(histogram_worker, &job, thread_count);
+
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    for (size_t chunk = 0; chunk < encoding->chunk_count; chunk++) {
+        for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+            counts[i] += job.chunk_counts[chunk][i];
+        }
+    }
+    bool built = build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH,
+                                            &encoding->codes);
+
+    // The index: each chunk starts where the previous one's bits end.
+    encoding->chunk_offsets[0] = 0;
+    for (size_t chunk = 0; built && chunk < encoding->chunk_count; chunk++) {
+        uint64_t bits = count_encoded_bits(&encoding->codes,
+                                           job.chunk_counts[chunk]);
+        encoding->chunk_offsets[chunk + 1] =
+            encoding->chunk_offsets[chunk] + (bits + CHAR_BIT - 1) / CHAR_BIT;
+    }
+    free(job.chunk_counts);
+    if (!built) {
+        free_wacky_parallel_encoding(encoding);
+        return false;
+    }
+
+    encoding->payload_size = encoding->chunk_offsets[encoding->chunk_count];
+    encoding->payload = malloc(MAX(encoding->payload_size, 1));
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    if (encoding->payload == NULL) {
+        free_wacky_parallel_encoding(encoding);
+        return false;
+    }
+    run_parallel_job(encode_worker, &job, thread_count);
+    if (atomic_load(&job.failed)) {
+        free_wacky_parallel_encoding(encoding);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Decodes a WackyParallelEncoding on several threads, one chunk at a time.
+ *
+ * @param encoding The output of wacky_parallel_encode().
+ * @param out Where to write the input_length decoded bytes.
+ * @param thread_count The number of threads to use, or 0 for one per core.
+ *
+ * @return false if the codes cannot be table-decoded or a chunk is corrupt.
+ */
+bool wacky_parallel_decode(WackyParallelEncoding* encoding, uint8_t* out,
+                           int thread_count) {
+    if (encoding == NULL || out == NULL) {
+        return false;
+    }
+    WackyDecodeTable table;
+    if (!build_wacky_decode_table(&encoding->codes, &table)) {
+        return false;
+    }
+
+    WackyParallelJob job = {
+        .output = out, .encoding = encoding, .decode_table = &table};
+    atomic_init(&job.failed, false);
+    run_parallel_job(decode_worker, &job, resolve_thread_count(thread_count));
+    free_wacky_decode_table(&table);
+    return !atomic_load(&job.failed);
+}
+
+#endif
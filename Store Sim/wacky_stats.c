@@ -0,0 +1,224 @@
+#ifndef WACKY_STATS_C
+#define WACKY_STATS_C
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Optional instrumentation for the encode and decode pipeline. Build with
+ * -DWACKY_STATS to turn it on. Without that flag every hook below expands to
+ * nothing, so the hot paths are exactly as they would be without this file.
+ *
+ * When it is on, the library keeps process-wide counters: symbols encoded and
+ * decoded, bits emitted, allocations, the height of every tree turned into a
+ * code table, the entropy of every histogram turned into canonical codes
+ * against the average length of those codes, and the calls to each stage and
+ * the time spent in them. The counters are updated once per call, never once
+ * per symbol. Updates are relaxed atomics, so the parallel codec's worker
+ * threads count too. wacky_get_stats() copies them into a WackyStats for
+ * export to other metrics systems.
+ *
+ * Stage times are in TSC cycles on x86 and in nanoseconds elsewhere. Only
+ * calls that succeed are timed.
+ */
+
+typedef enum {
+    WACKY_STAGE_HISTOGRAM,
+    WACKY_STAGE_TREE,
+    WACKY_STAGE_CODE_TABLE,
+    WACKY_STAGE_DECODE_TABLE,
+    WACKY_STAGE_ENCODE,
+    WACKY_STAGE_DECODE,
+    WACKY_STAGE_COUNT,
+} WackyStage;
+
+typedef struct WackyStats WackyStats;
+struct WackyStats {
+    uint64_t bytes_histogrammed;
+    uint64_t symbols_encoded;
+    uint64_t symbols_decoded;
+    uint64_t bits_emitted;
+    uint64_t allocations;
+    // Every tree turned into a code table by build_wacky_code_table(), and
+    // the longest code in any of them, in bits.
+    uint64_t trees_built;
+    int max_code_length;
+    // Over every histogram turned into codes by build_canonical_byte_table(),
+    // in bits per symbol: what the codes spend, and the lower bound.
+    double average_code_length;
+    double entropy;
+    uint64_t stage_calls[WACKY_STAGE_COUNT];
+    uint64_t stage_cycles[WACKY_STAGE_COUNT];
+};
+
+/**
+ * Returns the name of a stage, for labelling exported metrics.
+ */
+const char* wacky_stage_name(WackyStage stage) {
+    static const char* names[WACKY_STAGE_COUNT] = {
+        "histogram", "tree", "code_table", "decode_table", "encode", "decode",
+    };
+    return stage >= 0 && stage < WACKY_STAGE_COUNT ? names[stage] : "unknown";
+}
+
+#ifdef WACKY_STATS
+
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Entropy is summed in fixed point so it can be added atomically.
+#define WACKY_STATS_ENTROPY_SCALE 1024.0
+
+typedef enum {
+    WACKY_STAT_BYTES_HISTOGRAMMED,
+    WACKY_STAT_SYMBOLS_ENCODED,
+    WACKY_STAT_SYMBOLS_DECODED,
+    WACKY_STAT_BITS_EMITTED,
+    WACKY_STAT_ALLOCATIONS,
+    WACKY_STAT_TREES_BUILT,
+    WACKY_STAT_MAX_CODE_LENGTH,
+    WACKY_STAT_MODELLED_SYMBOLS,
+    WACKY_STAT_MODELLED_BITS,
+    WACKY_STAT_SCALED_ENTROPY_BITS,
+    WACKY_STAT_COUNT,
+} WackyStat;
+
+static uint64_t wacky_stat_counters[WACKY_STAT_COUNT];
+static uint64_t wacky_stage_calls[WACKY_STAGE_COUNT];
+static uint64_t wacky_stage_cycles[WACKY_STAGE_COUNT];
+
+static inline uint64_t wacky_stats_clock(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+#endif
+}
+
+static inline void wacky_stats_add(WackyStat stat, uint64_t amount) {
+    __atomic_fetch_add(&wacky_stat_counters[stat], amount, __ATOMIC_RELAXED);
+}
+
+static inline void wacky_stats_raise(WackyStat stat, uint64_t value) {
+    uint64_t seen = __atomic_load_n(&wacky_stat_counters[stat], __ATOMIC_RELAXED);
+    while (seen < value &&
+           !__atomic_compare_exchange_n(&wacky_stat_counters[stat], &seen, value,
+                                        true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+    }
+}
+
+static inline void wacky_stats_add_stage(WackyStage stage, uint64_t cycles) {
+    __atomic_fetch_add(&wacky_stage_calls[stage], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&wacky_stage_cycles[stage], cycles, __ATOMIC_RELAXED);
+}
+
+/**
+ * Records the `code_bits` a set of codes spends on the histogram it was built
+ * for, next to that histogram's entropy.
+ */
+void wacky_stats_add_model(const uint64_t counts[], int alphabet_size,
+                           uint64_t code_bits) {
+    uint64_t total = 0;
+    for (int i = 0; i < alphabet_size; i++) {
+        total += counts[i];
+    }
+    double entropy = 0;
+    for (int i = 0; i < alphabet_size; i++) {
+        if (counts[i] > 0) {
+            entropy += counts[i] * log2((double)total / counts[i]);
+        }
+    }
+    wacky_stats_add(WACKY_STAT_MODELLED_SYMBOLS, total);
+    wacky_stats_add(WACKY_STAT_MODELLED_BITS, code_bits);
+    wacky_stats_add(WACKY_STAT_SCALED_ENTROPY_BITS,
+                    (uint64_t)llround(entropy * WACKY_STATS_ENTROPY_SCALE));
+}
+
+#define WACKY_STAT(...) __VA_ARGS__
+#define WACKY_COUNT(stat, amount) wacky_stats_add(stat, amount)
+#define WACKY_RAISE(stat, value) wacky_stats_raise(stat, value)
+#define WACKY_STAGE_BEGIN(stage) \
+    uint64_t wacky_stage_start_##stage = wacky_stats_clock()
+#define WACKY_STAGE_END(stage) \
+    wacky_stats_add_stage(stage, wacky_stats_clock() - wacky_stage_start_##stage)
+
+#else
+
+#define WACKY_STAT(...)
+#define WACKY_COUNT(stat, amount) ((void)0)
+#define WACKY_RAISE(stat, value) ((void)0)
+#define WACKY_STAGE_BEGIN(stage) ((void)0)
+#define WACKY_STAGE_END(stage) ((void)0)
+
+#endif
+
+/**
+ * Returns true if the library was built with -DWACKY_STATS.
+ */
+bool wacky_stats_enabled(void) {
+#ifdef WACKY_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Copies the counters gathered so far. Without -DWACKY_STATS they are all 0.
+ */
+void wacky_get_stats(WackyStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+#ifdef WACKY_STATS
+    uint64_t counters[WACKY_STAT_COUNT];
+    for (int i = 0; i < WACKY_STAT_COUNT; i++) {
+        counters[i] = __atomic_load_n(&wacky_stat_counters[i], __ATOMIC_RELAXED);
+    }
+    stats->bytes_histogrammed = counters[WACKY_STAT_BYTES_HISTOGRAMMED];
+    stats->symbols_encoded = counters[WACKY_STAT_SYMBOLS_ENCODED];
+    stats->symbols_decoded = counters[WACKY_STAT_SYMBOLS_DECODED];
+    stats->bits_emitted = counters[WACKY_STAT_BITS_EMITTED];
+    stats->allocations = counters[WACKY_STAT_ALLOCATIONS];
+    stats->trees_built = counters[WACKY_STAT_TREES_BUILT];
+    stats->max_code_length = counters[WACKY_STAT_MAX_CODE_LENGTH];
+    uint64_t modelled = counters[WACKY_STAT_MODELLED_SYMBOLS];
+    if (modelled > 0) {
+        stats->average_code_length =
+            (double)counters[WACKY_STAT_MODELLED_BITS] / modelled;
+        stats->entropy = counters[WACKY_STAT_SCALED_ENTROPY_BITS] /
+                         WACKY_STATS_ENTROPY_SCALE / modelled;
+    }
+    for (int i = 0; i < WACKY_STAGE_COUNT; i++) {
+        stats->stage_calls[i] =
+            __atomic_load_n(&wacky_stage_calls[i], __ATOMIC_RELAXED);
+        stats->stage_cycles[i] =
+            __atomic_load_n(&wacky_stage_cycles[i], __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+/**
+ * Sets every counter back to 0.
+ */
+void wacky_reset_stats(void) {
+#ifdef WACKY_STATS
+    for (int i = 0; i < WACKY_STAT_COUNT; i++) {
+        __atomic_store_n(&wacky_stat_counters[i], 0, __ATOMIC_RELAXED);
+    }
+    for (int i = 0; i < WACKY_STAGE_COUNT; i++) {
+        __atomic_store_n(&wacky_stage_calls[i], 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&wacky_stage_cycles[i], 0, __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,494 @@
+#ifndef WACKY_STREAM_C
+#define WACKY_STREAM_C
+
+#include "wacky_context.c"
+#include "wacky_decode.c"
+
+/**
+ * Incremental encoder and decoder for framed byte streams. Both sides keep a
+ * fixed-size context and work on whatever input and output space the caller
+ * hands them, so arbitrarily long inputs can be processed in bounded memory.
+ *
+ * A stream is a run of frames, each of them
+ *
+ *   symbols  the number of symbols in the frame, a LEB128 varint, at least 1
+ *   size     the number of payload bytes, a LEB128 varint
+ *   payload  the symbols as a bit stream of encode_bytes_to_stream(), with
+ *            the last byte padded with zero bits
+ *
+ * followed by a single 0 byte, which reads as a frame of no symbols and ends
+ * the stream. The decoder needs nothing but the stream itself: the header
+ * tells it where each frame's padding starts, and the 0 byte where the
+ * stream stops, so bytes after it are left alone. The encoder closes a frame
+ * when its payload fills WACKY_STREAM_FRAME_BYTES, on
+ * wacky_stream_encoder_flush(), and on wacky_stream_encoder_finish().
+ *
+ * The frame layer below is shared with the adaptive coder in
+ * wacky_adaptive.c, which runs wacky_frame_encode() and wacky_frame_decode()
+ * once for every stretch of symbols between two model rebuilds.
+ */
+
+#define WACKY_STREAM_FRAME_BYTES 4096
+#define WACKY_FRAME_HEADER_SIZE (2 * WACKY_MAX_VARINT_SIZE)
+
+typedef enum {
+    // All input so far was consumed; feed more.
+    WACKY_STREAM_OK = 0,
+    // The output buffer is full; drain it and call again.
+    WACKY_STREAM_OUTPUT_FULL,
+    // The decoder has reached the end of the stream.
+    WACKY_STREAM_DONE,
+    WACKY_STREAM_ERROR,
+} WackyStreamStatus;
+
+typedef struct WackyFrameWriter WackyFrameWriter;
+struct WackyFrameWriter {
+    // The open frame.
+    WackyBitWriter writer;
+    uint8_t payload[WACKY_STREAM_FRAME_BYTES];
+    uint64_t symbol_count;
+    uint64_t bit_count;
+    // A closed frame still being copied out: `header`, then the first
+    // `payload_size` bytes of `payload`.
+    uint8_t header[WACKY_FRAME_HEADER_SIZE];
+    size_t header_size;
+    size_t payload_size;
+    size_t copied;
+    bool closed;
+    bool ended;
+    // The caller's output for the current call.
+    uint8_t* out;
+    uint8_t* end;
+};
+
+typedef struct WackyFrameReader WackyFrameReader;
+struct WackyFrameReader {
+    // The header read so far.
+    uint8_t header[WACKY_FRAME_HEADER_SIZE];
+    size_t header_size;
+    // What is left of the current frame.
+    uint64_t symbols_left;
+    uint64_t bytes_left;
+    uint64_t accumulator;
+    int available;
+    bool ended;
+};
+
+typedef struct WackyStreamEncoder WackyStreamEncoder;
+struct WackyStreamEncoder {
+    const WackyCodeTable* codes;
+    WackyFrameWriter frames;
+    uint64_t symbol_count;
+    uint64_t bytes_written;
+};
+
+typedef struct WackyStreamDecoder WackyStreamDecoder;
+struct WackyStreamDecoder {
+    const WackyDecodeTable* table;
+    WackyFrameReader frames;
+};
+
+void frame_writer_init(WackyFrameWriter* frames) {
+    bit_writer_init(&frames->writer, frames->payload, WACKY_STREAM_FRAME_BYTES);
+    frames->symbol_count = 0;
+    frames->bit_count = 0;
+    frames->header_size = 0;
+    frames->payload_size = 0;
+    frames->copied = 0;
+    frames->closed = false;
+    frames->ended = false;
+    frames->out = NULL;
+    frames->end = NULL;
+}
+
+void frame_writer_set_output(WackyFrameWriter* frames, uint8_t* out,
+                             size_t capacity) {
+    frames->out = out;
+    frames->end = out + capacity;
+}
+
+/**
+ * Copies as much of the closed frame to the output as fits, and reopens the
+ * payload once all of it is out.
+ *
+ * @return true if no closed frame is left to copy.
+ */
+bool drain_frame(WackyFrameWriter* frames) {
+    if (!frames->closed) {
+        return true;
+    }
+    size_t total = frames->header_size + frames->payload_size;
+    while (frames->copied < total && frames->out < frames->end) {
+        size_t n;
+        if (frames->copied < frames->header_size) {
+            n = MIN(frames->header_size - frames->copied,
+                    (size_t)(frames->end - frames->out));
+            memcpy(frames->out, &frames->header[frames->copied], n);
+        } else {
+            size_t offset = frames->copied - frames->header_size;
+            n = MIN(frames->payload_size - offset,
+                    (size_t)(frames->end - frames->out));
+            memcpy(frames->out, &frames->payload[offset], n);
+        }
+        frames->out += n;
+        frames->copied += n;
+    }
+    if (frames->copied < total) {
+        return false;
+    }
+    bit_writer_init(&frames->writer, frames->payload, WACKY_STREAM_FRAME_BYTES);
+    frames->symbol_count = 0;
+    frames->bit_count = 0;
+    frames->closed = false;
+    return true;
+}
+
+/**
+ * Closes the open frame, which must hold at least one symbol, and starts
+ * copying it out.
+ */
+void close_frame(WackyFrameWriter* frames) {
+    // The payload always has room for its own padding.
+    bit_writer_finish(&frames->writer);
+    frames->payload_size = (frames->bit_count + CHAR_BIT - 1) / CHAR_BIT;
+    frames->header_size = write_wacky_varint(frames->symbol_count,
+                                             frames->header,
+                                             WACKY_MAX_VARINT_SIZE);
+    frames->header_size += write_wacky_varint(
+        frames->payload_size, &frames->header[frames->header_size],
+        WACKY_MAX_VARINT_SIZE);
+    frames->copied = 0;
+    frames->closed = true;
+}
+
+/**
+ * The encoding step of both streaming coders: appends `count` bytes of `in`
+ * to the open frame with a fixed code table, closing full frames and
+ * copying them to the output as it goes.
+ *
+ * @param status Set to WACKY_STREAM_OK if all `count` bytes were taken,
+ * WACKY_STREAM_OUTPUT_FULL if the output ran out first, or
+ * WACKY_STREAM_ERROR if a byte has no code.
+ *
+ * @return The number of bytes taken.
+ */
+size_t wacky_frame_encode(WackyFrameWriter* frames, const WackyCodeTable* codes,
+                          const uint8_t* in, size_t count,
+                          WackyStreamStatus* status) {
+    *status = WACKY_STREAM_OK;
+    if (!drain_frame(frames)) {
+        *status = WACKY_STREAM_OUTPUT_FULL;
+        return 0;
+    }
+    size_t i = 0;
+    for (; i < count; i++) {
+        WackyCode code = codes->codes[in[i]];
+        if (code.length < 0) {
+            *status = WACKY_STREAM_ERROR;
+            break;
+        }
+        if (!bit_writer_put(&frames->writer, code.bits, code.length)) {
+            // The payload is full; the code opens the next frame.
+            close_frame(frames);
+            if (!drain_frame(frames)) {
+                *status = WACKY_STREAM_OUTPUT_FULL;
+                break;
+            }
+            bit_writer_put(&frames->writer, code.bits, code.length);
+        }
+        frames->symbol_count++;
+        frames->bit_count += code.length;
+    }
+    return i;
+}
+
+/**
+ * Closes the open frame, if it holds any symbols, and copies out what it
+ * can.
+ *
+ * @return WACKY_STREAM_OK once everything is out, or
+ * WACKY_STREAM_OUTPUT_FULL if the output needs to be drained and this called
+ * again.
+ */
+WackyStreamStatus wacky_frame_flush(WackyFrameWriter* frames) {
+    if (!drain_frame(frames)) {
+        return WACKY_STREAM_OUTPUT_FULL;
+    }
+    if (frames->symbol_count > 0) {
+        close_frame(frames);
+    }
+    return drain_frame(frames) ? WACKY_STREAM_OK : WACKY_STREAM_OUTPUT_FULL;
+}
+
+/**
+ * wacky_frame_flush(), then the 0 byte that ends the stream.
+ */
+WackyStreamStatus wacky_frame_finish(WackyFrameWriter* frames) {
+    if (wacky_frame_flush(frames) != WACKY_STREAM_OK) {
+        return WACKY_STREAM_OUTPUT_FULL;
+    }
+    if (!frames->ended) {
+        frames->header_size = write_wacky_varint(0, frames->header,
+                                                 WACKY_MAX_VARINT_SIZE);
+        frames->payload_size = 0;
+        frames->copied = 0;
+        frames->closed = true;
+        frames->ended = true;
+    }
+    return drain_frame(frames) ? WACKY_STREAM_OK : WACKY_STREAM_OUTPUT_FULL;
+}
+
+void frame_reader_init(WackyFrameReader* frames) {
+    frames->header_size = 0;
+    frames->symbols_left = 0;
+    frames->bytes_left = 0;
+    frames->accumulator = 0;
+    frames->available = 0;
+    frames->ended = false;
+}
+
+/**
+ * Reads header bytes until the next frame starts, the stream ends, or the
+ * input runs out.
+ *
+ * @return WACKY_STREAM_OK if a frame has started or more input is needed,
+ * WACKY_STREAM_DONE at the end of the stream, or WACKY_STREAM_ERROR on a
+ * malformed header.
+ */
+WackyStreamStatus read_frame_header(WackyFrameReader* frames, const uint8_t* in,
+                                    size_t in_size, size_t* position) {
+    while (*position < in_size) {
+        uint8_t byte = in[(*position)++];
+        frames->header[frames->header_size++] = byte;
+        if ((byte & 0x80) != 0) {
+            if (frames->header_size == WACKY_FRAME_HEADER_SIZE) {
+                return WACKY_STREAM_ERROR;
+            }
+            continue;
+        }
+        // A varint just ended: either the symbol count or the size after it.
+        uint64_t symbols;
+        uint64_t size;
+        size_t first =
+            read_wacky_varint(frames->header, frames->header_size, &symbols);
+        if (first == 0) {
+            return WACKY_STREAM_ERROR;
+        }
+        if (symbols == 0) {
+            frames->ended = true;
+            return WACKY_STREAM_DONE;
+        }
+        if (first == frames->header_size) {
+            continue;
+        }
+        if (read_wacky_varint(&frames->header[first],
+                              frames->header_size - first,
+                              &size) != frames->header_size - first) {
+            return WACKY_STREAM_ERROR;
+        }
+        frames->header_size = 0;
+        frames->symbols_left = symbols;
+        frames->bytes_left = size;
+        return WACKY_STREAM_OK;
+    }
+    return WACKY_STREAM_OK;
+}
+
+/**
+ * The decoding step of both streaming coders: decodes up to `limit` symbols
+ * with a fixed decode table, reading frame headers as it meets them. Input
+ * bytes are buffered inside the reader, so all of `in` may be consumed even
+ * when the last code in it is incomplete.
+ *
+ * @return WACKY_STREAM_OUTPUT_FULL once `limit` symbols are decoded,
+ * WACKY_STREAM_OK if more input is needed first, WACKY_STREAM_DONE at the end
+ * of the stream, or WACKY_STREAM_ERROR on an invalid code or a frame whose
+ * size does not match its symbols.
+ */
+WackyStreamStatus wacky_frame_decode(WackyFrameReader* frames,
+                                     const WackyDecodeTable* table,
+                                     const uint8_t* in, size_t in_size,
+                                     size_t* in_consumed, uint8_t* out,
+                                     size_t limit, size_t* out_written) {
+    size_t position = 0;
+    size_t produced = 0;
+    WackyStreamStatus status = WACKY_STREAM_OK;
+
+    for (;;) {
+        if (frames->symbols_left == 0) {
+            status = frames->ended ? WACKY_STREAM_DONE
+                                   : read_frame_header(frames, in, in_size,
+                                                       &position);
+            if (status != WACKY_STREAM_OK || frames->symbols_left == 0) {
+                break;
+            }
+            // Every code is at least a bit long unless one symbol has them all.
+            if (table->max_length > 0 &&
+                frames->symbols_left / CHAR_BIT > frames->bytes_left) {
+                status = WACKY_STREAM_ERROR;
+                break;
+            }
+        }
+        if (produced == limit) {
+            status = WACKY_STREAM_OUTPUT_FULL;
+            break;
+        }
+
+        if (table->max_length == 0) {
+            size_t run = MIN(limit - produced, frames->symbols_left);
+            memset(&out[produced], table->single_symbol, run);
+            produced += run;
+            frames->symbols_left -= run;
+        } else {
+            while (frames->available <= 56 && frames->bytes_left > 0 &&
+                   position < in_size) {
+                frames->accumulator |= (uint64_t)in[position++]
+                                       << frames->available;
+                frames->available += CHAR_BIT;
+                frames->bytes_left--;
+            }
+
+            int consumed;
+            WackyDecodeEntry* entry = lookup_decode_entry(
+                (WackyDecodeTable*)table, frames->accumulator, &consumed);
+            int used = consumed + entry->first_bits;
+            if (entry->type != WACKY_ENTRY_SYMBOLS) {
+                status = WACKY_STREAM_ERROR;
+                break;
+            }
+            if (used > frames->available) {
+                // Either the code continues in input we have not been given
+                // yet, or the frame ends in the middle of it.
+                status = frames->bytes_left > 0 ? WACKY_STREAM_OK
+                                                : WACKY_STREAM_ERROR;
+                break;
+            }
+
+            out[produced++] = entry->symbols[0];
+            frames->symbols_left--;
+            if (entry->count == 2 && entry->bits <= frames->available &&
+                frames->symbols_left > 0 && produced < limit) {
+                out[produced++] = entry->symbols[1];
+                frames->symbols_left--;
+                used = entry->bits;
+            }
+            frames->accumulator >>= used;
+            frames->available -= used;
+        }
+
+        if (frames->symbols_left == 0) {
+            // Only the zero padding of the last byte may be left.
+            if (frames->bytes_left > 0 || frames->available >= CHAR_BIT) {
+                status = WACKY_STREAM_ERROR;
+                break;
+            }
+            frames->accumulator = 0;
+            frames->available = 0;
+        }
+    }
+
+    *in_consumed = position;
+    *out_written = produced;
+    return status;
+}
+
+void wacky_stream_encoder_init(WackyStreamEncoder* encoder,
+                               const WackyCodeTable* codes) {
+    encoder->codes = codes;
+    frame_writer_init(&encoder->frames);
+    encoder->symbol_count = 0;
+    encoder->bytes_written = 0;
+}
+
+/**
+ * Encodes as much of `in` as fits in `out`. Output is written a frame at a
+ * time, so bytes may be taken without any output until a frame fills.
+ *
+ * @param encoder A context set up by wacky_stream_encoder_init().
+ * @param in The next bytes of input.
+ * @param in_size The number of bytes at `in`.
+ * @param in_consumed Set to the number of input bytes encoded.
+ * @param out Where to write encoded bytes.
+ * @param out_capacity The space at `out`.
+ * @param out_written Set to the number of bytes written.
+ *
+ * @return WACKY_STREAM_OK once all of `in` is consumed,
+ * WACKY_STREAM_OUTPUT_FULL if `out` ran out first, or WACKY_STREAM_ERROR if a
+ * byte has no code (it is left unconsumed).
+ */
+WackyStreamStatus wacky_stream_encode(WackyStreamEncoder* encoder,
+                                      const uint8_t* in, size_t in_size,
+                                      size_t* in_consumed, uint8_t* out,
+                                      size_t out_capacity,
+                                      size_t* out_written) {
+    WackyStreamStatus status;
+    frame_writer_set_output(&encoder->frames, out, out_capacity);
+    *in_consumed =
+        wacky_frame_encode(&encoder->frames, encoder->codes, in, in_size, &status);
+    *out_written = encoder->frames.out - out;
+    encoder->symbol_count += *in_consumed;
+    encoder->bytes_written += *out_written;
+    return status;
+}
+
+/**
+ * Writes out every symbol encoded so far as a complete frame, so the decoder
+ * can produce them all from the output written up to now.
+ *
+ * @return WACKY_STREAM_OK when done, or WACKY_STREAM_OUTPUT_FULL if `out`
+ * needs to be drained and this called again.
+ */
+WackyStreamStatus wacky_stream_encoder_flush(WackyStreamEncoder* encoder,
+                                             uint8_t* out, size_t out_capacity,
+                                             size_t* out_written) {
+    frame_writer_set_output(&encoder->frames, out, out_capacity);
+    WackyStreamStatus status = wacky_frame_flush(&encoder->frames);
+    *out_written = encoder->frames.out - out;
+    encoder->bytes_written += *out_written;
+    return status;
+}
+
+/**
+ * Flushes the encoder and ends the stream.
+ *
+ * @return WACKY_STREAM_OK when done, or WACKY_STREAM_OUTPUT_FULL if `out`
+ * needs to be drained and this called again.
+ */
+WackyStreamStatus wacky_stream_encoder_finish(WackyStreamEncoder* encoder,
+                                              uint8_t* out, size_t out_capacity,
+                                              size_t* out_written) {
+    frame_writer_set_output(&encoder->frames, out, out_capacity);
+    WackyStreamStatus status = wacky_frame_finish(&encoder->frames);
+    *out_written = encoder->frames.out - out;
+    encoder->bytes_written += *out_written;
+    return status;
+}
+
+/**
+ * @param decoder The context to set up.
+ * @param table A decode table built by build_wacky_decode_table(). It must
+ * outlive the decoder.
+ */
+void wacky_stream_decoder_init(WackyStreamDecoder* decoder,
+                               const WackyDecodeTable* table) {
+    decoder->table = table;
+    frame_reader_init(&decoder->frames);
+}
+
+/**
+ * Decodes as many symbols as the input and output space allow.
+ *
+ * @return WACKY_STREAM_DONE at the end of the stream, WACKY_STREAM_OK if more
+ * input is needed, WACKY_STREAM_OUTPUT_FULL if `out` ran out first, or
+ * WACKY_STREAM_ERROR on corrupt input.
+ */
+WackyStreamStatus wacky_stream_decode(WackyStreamDecoder* decoder,
+                                      const uint8_t* in, size_t in_size,
+                                      size_t* in_consumed, uint8_t* out,
+                                      size_t out_capacity,
+                                      size_t* out_written) {
+    return wacky_frame_decode(&decoder->frames, decoder->table, in, in_size,
+                              in_consumed, out, out_capacity, out_written);
+}
+
+#endif
@@ -0,0 +1,1599 @@
+/**
+ * Tests for the table-driven codec modules. Each encoder/decoder is checked
+ * against the tree-based reference functions in wackman.c.
+ */
+
+// fmemopen() is POSIX, not part of ISO C.
+#define _DEFAULT_SOURCE
+
+#include <assert.h>
+
+#include "beanstalk.c"
+#include "wacky_batch.c"
+#include "wacky_beanstalk_codec.c"
+#include "wacky_adaptive.c"
+#include "wacky_blocks.c"
+#include "wacky_build.c"
+#include "wacky_canonical.c"
+#include "wacky_container.c"
+#include "wacky_context.c"
+#include "wacky_decode.c"
+#include "wacky_flat.c"
+#include "wacky_generate.c"
+#include "wacky_histogram.c"
+#include "wacky_interleave.c"
+#include "wacky_limit.c"
+#include "wacky_order1.c"
+#include "wacky_parallel.c"
+#include "wacky_stream.c"
+#include "wacky_train.c"
+
+/**
+ * Ends the run, naming the failed check and its line, unless `cond` holds.
+ */
+#define CHECK(cond, name)                                                     \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            printf("%s failed (line %d)\n", name, __LINE__);                 \
+            exit(1);                                                          \
+        }                                                                     \
+    } while (0)
+
+/**
+ * Builds the Jack and the Beanstalk tree used throughout main.c.
+ */
+WackyTreeNode* beanstalk_tree() {
+    int occurrence_array[ASCII_CHARACTER_SET_SIZE];
+    compute_occurrence_array(occurrence_array, (char*)JACK_AND_THE_BEANSTALK);
+    return merge_wacky_list(create_wacky_list(occurrence_array));
+}
+
+/**
+ * Builds a tree with Fibonacci weights over 'A'.. so codes reach `count` - 1
+ * bits and the decoder has to follow sub-table links.
+ */
+WackyTreeNode* skewed_tree(int count) {
+    int occurrence_array[ASCII_CHARACTER_SET_SIZE] = {0};
+    int a = 1, b = 1;
+    for (int i = 0; i < count; i++) {
+        occurrence_array['A' + i] = a;
+        int next = a + b;
+        a = b;
+        b = next;
+    }
+    return merge_wacky_list(create_wacky_list(occurrence_array));
+}
+
+bool same_tree(WackyTreeNode* a, WackyTreeNode* b) {
+    if (a == NULL || b == NULL) {
+        return a == b;
+    }
+    return a->val == b->val && a->count == b->count && a->weight == b->weight &&
+           same_tree(a->left, b->left) && same_tree(a->right, b->right);
+}
+
+/**
+ * The total number of bits `table` spends on the given occurrences.
+ */
+uint64_t code_cost(WackyCodeTable* table, int occurrence_array[], int size) {
+    uint64_t cost = 0;
+    for (int i = 0; i < size; i++) {
+        if (occurrence_array[i] > 0) {
+            cost += (uint64_t)occurrence_array[i] * table->codes[i].length;
+        }
+    }
+    return cost;
+}
+
+/**
+ * Trees: building (wacky_build.c), arenas, flat trees (wacky_flat.c) and
+ * length limits (wacky_limit.c).
+ */
+
+void tests_build_wacky_tree() {
+    printf("\n   - testing build_wacky_tree()..........");
+
+    int occurrence_array[ASCII_CHARACTER_SET_SIZE];
+    //T1
+    CHECK(build_wacky_tree(NULL) == NULL, "T1");
+    compute_occurrence_array(occurrence_array, "");
+    CHECK(build_wacky_tree(occurrence_array) == NULL, "T1");
+
+    //T2 the beanstalk tree
+    WackyTreeNode* expected = beanstalk_tree();
+    compute_occurrence_array(occurrence_array, (char*)JACK_AND_THE_BEANSTALK);
+    WackyTreeNode* tree = build_wacky_tree(occurrence_array);
+    CHECK(same_tree(tree, expected), "T2");
+    free_tree(tree);
+    free_tree(expected);
+
+    //T3 random counts with lots of ties
+    srand(42);
+    for (int round = 0; round < 500; round++) {
+        for (int i = 0; i < ASCII_CHARACTER_SET_SIZE; i++) {
+            occurrence_array[i] = (rand() % 4 == 0) ? rand() % 6 : 0;
+        }
+        expected = merge_wacky_list(create_wacky_list(occurrence_array));
+        tree = build_wacky_tree(occurrence_array);
+        CHECK(same_tree(tree, expected), "T3");
+        free_tree(tree);
+        free_tree(expected);
+    }
+
+    //T4 ties are exact: 1 + 2 ties with 3 even though 0.1 + 0.2 != 0.3
+    memset(occurrence_array, 0, sizeof(occurrence_array));
+    for (int i = 0; i < 10; i++) {
+        occurrence_array[(uint8_t)"abbcccdddd"[i]]++;
+    }
+    expected = merge_wacky_list(create_wacky_list(occurrence_array));
+    tree = build_wacky_tree(occurrence_array);
+    CHECK(same_tree(tree, expected) && expected->count == 10 &&
+          expected->left->val == 'd' && !is_wacky_leaf(expected->right->left) &&
+          expected->right->right->val == 'c', "T4");
+    free_tree(tree);
+    free_tree(expected);
+
+    //T5 counts past the int range
+    uint64_t counts[ASCII_CHARACTER_SET_SIZE] = {0};
+    counts['x'] = (uint64_t)1 << 40;
+    counts['y'] = ((uint64_t)1 << 40) + 1;
+    counts['z'] = (uint64_t)1 << 41;
+    tree = build_wacky_tree_from_counts(NULL, counts, ASCII_CHARACTER_SET_SIZE);
+    CHECK(tree != NULL && tree->count == ((uint64_t)1 << 42) + 1 &&
+          tree->left->val == 'z' && tree->right->left->val == 'x' &&
+          fabs(tree->weight - 1) <= 1e-9, "T5");
+    free_tree(tree);
+
+    //T6 lists of weight-only leaves still merge by weight
+    char vals[4] = {'x', 'y', 'z', 'w'};
+    double weights[4] = {0.1, 0.1, 0.15, 0.5};
+    WackyLinkedNode* list = NULL;
+    for (int i = 3; i >= 0; i--) {
+        WackyLinkedNode* node = new_linked_node(new_leaf_node(weights[i], vals[i]));
+        node->next = list;
+        list = node;
+    }
+    // x + y weighs more than z, so z is merged next.
+    tree = merge_wacky_list(list);
+    CHECK(tree->right->val == 'w' && is_wacky_leaf(tree->left->left) &&
+          tree->left->left->val == 'z', "T6");
+    free_tree(tree);
+
+    printf("works.");
+}
+
+void tests_wacky_arena() {
+    printf("\n   - testing new_wacky_arena()..........");
+
+    int occurrence_array[ASCII_CHARACTER_SET_SIZE];
+    compute_occurrence_array(occurrence_array, (char*)JACK_AND_THE_BEANSTALK);
+    int count = count_positive_occurrences(occurrence_array);
+    WackyTreeNode* expected = beanstalk_tree();
+
+    //T1 list construction and merging inside one block
+    WackyArena* arena = new_wacky_arena(count);
+    WackyTreeNode* tree =
+        merge_wacky_list_in(arena, create_wacky_list_in(arena, occurrence_array));
+    CHECK(same_tree(tree, expected) && arena->tree_used == 2 * count - 1, "T1");
+    free_wacky_arena(arena);
+
+    //T2 the heap builder
+    arena = new_wacky_arena(count);
+    tree = build_wacky_tree_in(arena, occurrence_array);
+    CHECK(same_tree(tree, expected) && arena->linked_used == 0, "T2");
+    free_wacky_arena(arena);
+
+    //T3 a full arena refuses more nodes
+    arena = new_wacky_arena(1);
+    assert(arena_leaf_node(arena, 1, 1.0, 'a') != NULL);
+    CHECK(arena_tree_node(arena) == NULL, "T3");
+    free_wacky_arena(arena);
+
+    //T4 builders running out of nodes return NULL
+    arena = new_wacky_arena(count / 2);
+    CHECK(build_wacky_tree_in(arena, occurrence_array) == NULL, "T4");
+    free_wacky_arena(arena);
+    // Room for every leaf but not every branch.
+    arena = new_wacky_arena(count / 2 + 1);
+    tree = merge_wacky_list_in(arena,
+                               create_wacky_list_in(arena, occurrence_array));
+    CHECK(tree == NULL, "T4");
+    free_wacky_arena(arena);
+    free_tree(expected);
+
+    printf("works.");
+}
+
+void tests_flat_tree() {
+    printf("\n   - testing flatten_wacky_tree()..........");
+
+    WackyFlatTree flat;
+    //T1
+    CHECK(!flatten_wacky_tree(NULL, &flat), "T1");
+
+    //T2 height, weights and codes agree with the pointer tree
+    WackyTreeNode* tree = beanstalk_tree();
+    assert(flatten_wacky_tree(tree, &flat));
+    CHECK(flat_get_height(&flat) == 13 && flat.branch_count == 43 &&
+          flat.branch_weights[0] == tree->weight &&
+          flat.leaf_weights['a'] ==
+              tree->right->left->right->right->weight, "T2");
+    bool boolean_array[128];
+    int array_size;
+    for (int c = 1; c < ASCII_CHARACTER_SET_SIZE; c++) {
+        get_wacky_code(tree, c, boolean_array, &array_size);
+        CHECK(array_size <= 0 ||
+              flat_get_character(&flat, boolean_array, array_size) == c, "T2");
+    }
+    CHECK(flat_get_character(&flat, boolean_array, 0) == '\0', "T2");
+
+    //T3 the message from main.c
+    int encoded[8] = {45,          -79266821,  1814895092, 1834766313,
+                      -2003211311, -229391379, -478575313, 235};
+    char* string = flat_decode_ints(&flat, encoded, 8);
+    CHECK(strcmp(string,
+                 "you have finished this assignment, well done!") == 0, "T3");
+    free(string);
+    free_tree(tree);
+
+    //T4 a single leaf
+    tree = skewed_tree(1);
+    assert(flatten_wacky_tree(tree, &flat));
+    int single[2] = {2, 0};
+    string = flat_decode_ints(&flat, single, 2);
+    CHECK(flat_get_height(&flat) == 1 && strcmp(string, "AA") == 0, "T4");
+    free(string);
+    free_tree(tree);
+
+    //T5 corrupt lengths are refused before allocating
+    tree = beanstalk_tree();
+    assert(flatten_wacky_tree(tree, &flat));
+    encoded[0] = -1;
+    CHECK(flat_decode_ints(&flat, encoded, 8) == NULL, "T5");
+    encoded[0] = 7 * 32 + 1;
+    CHECK(flat_decode_ints(&flat, encoded, 8) == NULL, "T5");
+    encoded[0] = 45;
+    CHECK(flat_decode_ints(&flat, encoded, 7) == NULL, "T5");
+    free_tree(tree);
+
+    printf("works.");
+}
+
+void tests_length_limit() {
+    printf("\n   - testing merge_wacky_list_limited()..........");
+
+    //T1 the optimal lengths under a tight limit
+    uint64_t weights[] = {1, 1, 2, 4, 8};
+    int lengths[5];
+    CHECK(limit_code_lengths(weights, 5, 3, lengths) && lengths[0] == 3 &&
+          lengths[1] == 3 && lengths[2] == 3 && lengths[3] == 3 &&
+          lengths[4] == 1, "T1");
+
+    //T2 a 40-level tree is cut down to 12 with every character kept
+    int occurrence_array[ASCII_CHARACTER_SET_SIZE] = {0};
+    int a = 1, b = 1;
+    for (int i = 0; i < 40; i++) {
+        occurrence_array['A' + i] = a;
+        int next = a + b;
+        a = b;
+        b = next;
+    }
+    WackyLinkedNode* list = create_wacky_list(occurrence_array);
+    WackyTreeNode* tree = merge_wacky_list_limited(list, 12);
+    WackyCodeTable codes;
+    CHECK(tree != NULL && get_height(tree) == 13 &&
+          build_wacky_code_table(tree, &codes) && codes.max_length == 12 &&
+          canonicalize_wacky_code_table(&codes), "T2");
+    for (int i = 0; i < 40; i++) {
+        CHECK(codes.codes['A' + i].length >= 1, "T2");
+    }
+    free_tree(tree);
+
+    //T3 a limit that is too small leaves the list for the normal merge
+    list = create_wacky_list(occurrence_array);
+    CHECK(merge_wacky_list_limited(list, 5) == NULL, "T3");
+    tree = merge_wacky_list(list);
+    CHECK(build_wacky_code_table(tree, &codes) && codes.max_length == 39, "T3");
+    free_tree(tree);
+
+    //T4 a loose limit costs exactly as much as the unlimited tree
+    compute_occurrence_array(occurrence_array, (char*)JACK_AND_THE_BEANSTALK);
+    WackyCodeTable limited;
+    tree = beanstalk_tree();
+    build_wacky_code_table(tree, &codes);
+    free_tree(tree);
+    tree = merge_wacky_list_limited(create_wacky_list(occurrence_array), 20);
+    build_wacky_code_table(tree, &limited);
+    CHECK(code_cost(&limited, occurrence_array, ASCII_CHARACTER_SET_SIZE) ==
+              code_cost(&codes, occurrence_array,
+                        ASCII_CHARACTER_SET_SIZE), "T4");
+    free_tree(tree);
+
+    //T5 byte tables are limited for single-lookup decoding
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    int occurrences[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    uint64_t x = 1, y = 1;
+    for (int i = 0; i < 60; i++) {
+        counts[200 + i % 56] += x;
+        uint64_t next = x + y;
+        x = y;
+        y = next;
+    }
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        occurrences[i] = counts[i] > 0;
+    }
+    CHECK(build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH, &codes) &&
+          codes.max_length <= WACKY_MAX_DECODE_LENGTH &&
+          limit_wacky_code_table(&codes, counts, WACKY_ROOT_TABLE_BITS) &&
+          codes.max_length == WACKY_ROOT_TABLE_BITS &&
+          code_cost(&codes, occurrences, WACKY_BYTE_ALPHABET_SIZE) != 0, "T5");
+    WackyDecodeTable table;
+    uint8_t data[56], stream[64 * 8], decoded[56];
+    size_t stream_size;
+    for (int i = 0; i < 56; i++) {
+        data[i] = 255 - i;
+    }
+    assert(build_wacky_decode_table(&codes, &table));
+    assert(encode_bytes_to_stream(&codes, data, sizeof(data), stream,
+                                  sizeof(stream), &stream_size));
+    CHECK(decode_bytes_with_table(&table, stream, stream_size, decoded,
+                                  sizeof(decoded)) &&
+          memcmp(decoded, data, sizeof(data)) == 0, "T5");
+    free_wacky_decode_table(&table);
+
+    printf("works.");
+}
+
+/**
+ * Codes: bit output (wacky_bits.c), code tables (wacky_codes.c), decode tables
+ * (wacky_decode.c), headers (wacky_canonical.c) and byte histograms
+ * (wacky_histogram.c).
+ */
+
+void tests_bit_writer() {
+    printf("\n   - testing bit_writer_put()..........");
+
+    //T1 bit k of the output is bit k % 8 of byte k / 8
+    uint8_t out[16] = {0};
+    WackyBitWriter writer;
+    bit_writer_init(&writer, out, sizeof(out));
+    bit_writer_put(&writer, 0x5, 3);
+    bit_writer_put(&writer, 0x1F, 5);
+    bit_writer_put(&writer, 0x1, 1);
+    CHECK(bit_writer_finish(&writer) && writer.out == &out[2] &&
+          out[0] == 0xFD && out[1] == 0x01, "T1");
+
+    //T2 codes of up to 64 bits straddle the word flushes
+    memset(out, 0, sizeof(out));
+    bit_writer_init(&writer, out, sizeof(out));
+    bit_writer_put(&writer, 0x7, 3);
+    bit_writer_put(&writer, 0x8000000000000001ull, 64);
+    bit_writer_put(&writer, 0x3, 2);
+    uint8_t expected[] = {0x0F, 0, 0, 0, 0, 0, 0, 0, 0x1C};
+    CHECK(bit_writer_finish(&writer) && writer.out == &out[sizeof(expected)] &&
+          memcmp(out, expected, sizeof(expected)) == 0, "T2");
+
+    //T3 a code that does not fit is refused whole and can go to a new buffer
+    uint8_t small[2];
+    bit_writer_init(&writer, small, 1);
+    CHECK(bit_writer_put(&writer, 0xC, 4) &&
+          !bit_writer_put(&writer, 0xAB, 8), "T3");
+    bit_writer_set_output(&writer, small, sizeof(small));
+    CHECK(bit_writer_put(&writer, 0xAB, 8) && bit_writer_finish(&writer) &&
+          small[0] == 0xBC && small[1] == 0x0A, "T3");
+
+    printf("works.");
+}
+
+void tests_build_wacky_code_table() {
+    printf("\n   - testing build_wacky_code_table()..........");
+
+    WackyCodeTable table;
+    //T1
+    CHECK(!build_wacky_code_table(NULL, &table), "T1");
+
+    //T2 every code matches get_wacky_code()
+    WackyTreeNode* tree = beanstalk_tree();
+    assert(build_wacky_code_table(tree, &table));
+    bool boolean_array[128];
+    int array_size;
+    for (int c = 1; c < ASCII_CHARACTER_SET_SIZE; c++) {
+        get_wacky_code(tree, c, boolean_array, &array_size);
+        CHECK(array_size == table.codes[c].length, "T2");
+        for (int i = 0; i < array_size; i++) {
+            CHECK(boolean_array[i] == ((table.codes[c].bits >> i) & 1), "T2");
+        }
+    }
+    CHECK(table.max_length == get_height(tree) - 1, "T2");
+    free_tree(tree);
+
+    //T3 a single leaf gets the empty code
+    int occurrence_array[ASCII_CHARACTER_SET_SIZE];
+    compute_occurrence_array(occurrence_array, "bbb");
+    tree = merge_wacky_list(create_wacky_list(occurrence_array));
+    assert(build_wacky_code_table(tree, &table));
+    CHECK(table.codes['b'].length == 0 && table.codes['a'].length == -1, "T3");
+    free_tree(tree);
+
+    printf("works.");
+}
+
+void tests_encode_string_with_table() {
+    printf("\n   - testing encode_string_with_table()..........");
+
+    WackyTreeNode* tree = beanstalk_tree();
+    WackyCodeTable table;
+    build_wacky_code_table(tree, &table);
+
+    //T1
+    CHECK(encode_string_with_table(&table, "") == NULL &&
+          encode_string_with_table(&table, NULL) == NULL, "T1");
+
+    //T2 characters that are not in the tree
+    CHECK(encode_string_with_table(&table, "Jack#") == NULL, "T2");
+
+    //T3 the whole story round-trips through the reference decoder
+    int* ints = encode_string_with_table(&table, (char*)JACK_AND_THE_BEANSTALK);
+    CHECK(ints != NULL && ints[0] == (int)strlen(JACK_AND_THE_BEANSTALK), "T3");
+    bool boolean_array[128];
+    int bit_index = 0;
+    for (int i = 0; i < ints[0]; i++) {
+        int length = table.codes[(unsigned char)JACK_AND_THE_BEANSTALK[i]].length;
+        for (int j = 0; j < length; j++, bit_index++) {
+            boolean_array[j] = findBit(ints[1 + bit_index / 32], bit_index % 32);
+        }
+        CHECK(get_character(tree, boolean_array, length) ==
+                  JACK_AND_THE_BEANSTALK[i], "T3");
+    }
+    free(ints);
+    free_tree(tree);
+
+    printf("works.");
+}
+
+void tests_decode_ints_with_table() {
+    printf("\n   - testing decode_ints_with_table()..........");
+
+    WackyTreeNode* tree = beanstalk_tree();
+    WackyCodeTable codes;
+    WackyDecodeTable table;
+    build_wacky_code_table(tree, &codes);
+    assert(build_wacky_decode_table(&codes, &table));
+
+    //T1
+    CHECK(decode_ints_with_table(&table, NULL, 1) == NULL, "T1");
+
+    //T2 the message from main.c
+    int encoded[8] = {45,          -79266821,  1814895092, 1834766313,
+                      -2003211311, -229391379, -478575313, 235};
+    char* string = decode_ints_with_table(&table, encoded, 8);
+    CHECK(strcmp(string,
+                 "you have finished this assignment, well done!") == 0, "T2");
+    free(string);
+
+    //T3 corrupt lengths are refused before allocating, and the words are
+    //never read past int_count
+    encoded[0] = -1;
+    CHECK(decode_ints_with_table(&table, encoded, 8) == NULL, "T3");
+    encoded[0] = INT_MAX;
+    CHECK(decode_ints_with_table(&table, encoded, 8) == NULL, "T3");
+    encoded[0] = 45;
+    CHECK(decode_ints_with_table(&table, encoded, 7) == NULL, "T3");
+
+    //T4 every prefix of the story round-trips
+    for (int length = 1; length < 200; length++) {
+        char prefix[200];
+        memcpy(prefix, JACK_AND_THE_BEANSTALK, length);
+        prefix[length] = '\0';
+        int* ints = encode_string_with_table(&codes, prefix);
+        string = decode_ints_with_table(
+            &table, ints,
+            count_encoded_ints(&codes, (unsigned char*)prefix, length));
+        CHECK(strcmp(string, prefix) == 0, "T4");
+        free(ints);
+        free(string);
+    }
+    free_wacky_decode_table(&table);
+    free_tree(tree);
+
+    //T5 codes longer than the root table
+    tree = skewed_tree(26);
+    build_wacky_code_table(tree, &codes);
+    assert(codes.max_length == 25);
+    assert(build_wacky_decode_table(&codes, &table));
+    char* text = "ZYXABCDEFGHIJKLMNOPQRSTUVWZZZAAAAZ";
+    int* ints = encode_string_with_table(&codes, text);
+    string = decode_ints_with_table(
+        &table, ints,
+        count_encoded_ints(&codes, (unsigned char*)text, strlen(text)));
+    CHECK(strcmp(string, text) == 0, "T5");
+    free(ints);
+    free(string);
+    free_wacky_decode_table(&table);
+    free_tree(tree);
+
+    //T6 a single leaf
+    tree = skewed_tree(1);
+    build_wacky_code_table(tree, &codes);
+    assert(build_wacky_decode_table(&codes, &table));
+    int single[2] = {3, 0};
+    string = decode_ints_with_table(&table, single, 2);
+    CHECK(strcmp(string, "AAA") == 0, "T6");
+    free(string);
+    free_wacky_decode_table(&table);
+    free_tree(tree);
+
+    printf("works.");
+}
+
+void tests_wacky_header() {
+    printf("\n   - testing write_wacky_header()/read_wacky_header()..........");
+
+    WackyTreeNode* tree = beanstalk_tree();
+    WackyCodeTable tree_codes, codes, read_codes;
+    build_wacky_code_table(tree, &tree_codes);
+    codes = tree_codes;
+
+    //T1 canonical codes keep every length
+    assert(canonicalize_wacky_code_table(&codes));
+    for (int c = 0; c < ASCII_CHARACTER_SET_SIZE; c++) {
+        CHECK(codes.codes[c].length == tree_codes.codes[c].length, "T1");
+    }
+
+    //T2 the 44-symbol header takes a few dozen bytes and reads back
+    uint8_t header[WACKY_MAX_HEADER_SIZE];
+    size_t size = write_wacky_header(&codes, header, sizeof(header));
+    CHECK(size != 0 && size <= 48, "T2");
+    CHECK(read_wacky_header(header, size, &read_codes) == size, "T2");
+    for (int c = 0; c < ASCII_CHARACTER_SET_SIZE; c++) {
+        CHECK(read_codes.codes[c].length == codes.codes[c].length &&
+              read_codes.codes[c].bits == codes.codes[c].bits, "T2");
+    }
+
+    //T3 truncated headers are rejected
+    CHECK(read_wacky_header(header, size - 1, &read_codes) == 0 &&
+          write_wacky_header(&codes, header, size - 1) == 0, "T3");
+
+    //T4 the rebuilt table decodes its own output
+    WackyDecodeTable table;
+    assert(build_wacky_decode_table(&read_codes, &table));
+    int* ints = encode_string_with_table(&codes, (char*)JACK_AND_THE_BEANSTALK);
+    char* string = decode_ints_with_table(
+        &table, ints,
+        count_encoded_ints(&codes, (unsigned char*)JACK_AND_THE_BEANSTALK,
+                           strlen(JACK_AND_THE_BEANSTALK)));
+    CHECK(strcmp(string, JACK_AND_THE_BEANSTALK) == 0, "T4");
+    free(ints);
+    free(string);
+    free_wacky_decode_table(&table);
+    free_tree(tree);
+
+    //T5 over-subscribed lengths are rejected
+    build_wacky_code_table(NULL, &codes);
+    codes.codes['a'].length = 1;
+    codes.codes['b'].length = 1;
+    codes.codes['c'].length = 1;
+    CHECK(!canonicalize_wacky_code_table(&codes), "T5");
+
+    //T6 64-bit lengths: a full code gets distinct codes, one more is refused
+    build_wacky_code_table(NULL, &codes);
+    for (int length = 1; length < WACKY_MAX_CODE_LENGTH; length++) {
+        codes.codes[length].length = length;
+    }
+    codes.codes[100].length = WACKY_MAX_CODE_LENGTH;
+    codes.codes[101].length = WACKY_MAX_CODE_LENGTH;
+    CHECK(canonicalize_wacky_code_table(&codes) &&
+          codes.codes[100].bits != codes.codes[101].bits, "T6");
+    codes.codes[102].length = WACKY_MAX_CODE_LENGTH;
+    CHECK(!canonicalize_wacky_code_table(&codes), "T6");
+
+    //T7 headers declaring codes the decoder cannot read are refused
+    memset(header, 0, sizeof(header));
+    header[0] = 1;
+    header[3 + 'a' / CHAR_BIT] = 1 << ('a' % CHAR_BIT);
+    header[3 + 'b' / CHAR_BIT] |= 1 << ('b' % CHAR_BIT);
+    header[1] = 1;
+    CHECK(read_wacky_header(header, 19, &read_codes) == 19, "T7");
+    header[1] = WACKY_MAX_DECODE_LENGTH + 1;
+    CHECK(read_wacky_header(header, 19, &read_codes) == 0, "T7");
+
+    printf("works.");
+}
+
+void tests_byte_alphabet() {
+    printf("\n   - testing the 256-byte alphabet..........");
+
+    //T1 bytes above 127 no longer write out of bounds
+    int ascii_array[ASCII_CHARACTER_SET_SIZE];
+    compute_occurrence_array(ascii_array, "a\xff\x80" "b");
+    CHECK(sum_array_elements(ascii_array, ASCII_CHARACTER_SET_SIZE) == 2, "T1");
+
+    //T2 every byte value, NUL included, round-trips
+    unsigned char data[3000];
+    for (int i = 0; i < 3000; i++) {
+        data[i] = (i % 7 == 0) ? 0 : (i * i) % 256;
+    }
+    int occurrence_array[WACKY_BYTE_ALPHABET_SIZE];
+    compute_byte_occurrence_array(occurrence_array, data, sizeof(data));
+    CHECK(occurrence_array[0] == 590 &&
+          sum_array_elements(occurrence_array,
+                             WACKY_BYTE_ALPHABET_SIZE) == 3000, "T2");
+    WackyTreeNode* tree = build_wacky_byte_tree(occurrence_array);
+    WackyCodeTable codes;
+    WackyDecodeTable table;
+    assert(build_wacky_code_table(tree, &codes));
+    assert(codes.codes[0].length > 0 && codes.codes[0xff].length < 0);
+    assert(build_wacky_decode_table(&codes, &table));
+    int* ints = encode_bytes_with_table(&codes, data, sizeof(data));
+    size_t int_count = count_encoded_ints(&codes, data, sizeof(data));
+    char* string = decode_ints_with_table(&table, ints, int_count);
+    CHECK(ints[0] == 3000 && memcmp(string, data, sizeof(data)) == 0, "T2");
+    free(string);
+
+    //T3 the flat tree sees NUL as a leaf
+    WackyFlatTree flat;
+    assert(flatten_wacky_tree(tree, &flat));
+    string = flat_decode_ints(&flat, ints, int_count);
+    CHECK(memcmp(string, data, sizeof(data)) == 0, "T3");
+    free(string);
+    free(ints);
+    free_wacky_decode_table(&table);
+
+    //T4 wide headers
+    WackyCodeTable read_codes;
+    uint8_t header[WACKY_MAX_HEADER_SIZE];
+    canonicalize_wacky_code_table(&codes);
+    size_t size = write_wacky_header(&codes, header, sizeof(header));
+    CHECK(size != 0 && (header[2] & WACKY_HEADER_WIDE_FLAG) &&
+          read_wacky_header(header, size, &read_codes) == size, "T4");
+    for (int c = 0; c < WACKY_BYTE_ALPHABET_SIZE; c++) {
+        CHECK(read_codes.codes[c].length == codes.codes[c].length, "T4");
+    }
+    free_tree(tree);
+
+    printf("works.");
+}
+
+void tests_compute_byte_histogram() {
+    printf("\n   - testing compute_byte_histogram()..........");
+
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    //T1
+    compute_byte_histogram(counts, NULL, 10);
+    compute_byte_histogram(counts, (const uint8_t*)"abc", 0);
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        CHECK(counts[i] == 0, "T1");
+    }
+
+    //T2 every length around the word boundaries, counts accumulate
+    unsigned char data[100];
+    for (int i = 0; i < 100; i++) {
+        data[i] = (i % 3 == 0) ? ' ' : 200 + i % 5;
+    }
+    int expected[WACKY_BYTE_ALPHABET_SIZE];
+    for (size_t length = 0; length <= sizeof(data); length++) {
+        uint64_t totals[WACKY_BYTE_ALPHABET_SIZE] = {0};
+        compute_byte_histogram(totals, data, length);
+        compute_byte_histogram(totals, data, length);
+        compute_byte_occurrence_array(expected, data, length);
+        for (int c = 0; c < WACKY_BYTE_ALPHABET_SIZE; c++) {
+            CHECK(totals[c] == 2 * (uint64_t)expected[c], "T2");
+        }
+    }
+
+    //T3 the occurrence array adapter
+    int occurrence_array[WACKY_BYTE_ALPHABET_SIZE];
+    compute_fast_occurrence_array(occurrence_array,
+                                  (const uint8_t*)JACK_AND_THE_BEANSTALK,
+                                  strlen(JACK_AND_THE_BEANSTALK));
+    CHECK(occurrence_array['a'] == 231 && occurrence_array['f'] == 60, "T3");
+
+    printf("works.");
+}
+
+/**
+ * Whole buffers: containers (wacky_container.c), blocks (wacky_blocks.c),
+ * order-1 contexts (wacky_order1.c), interleaved streams (wacky_interleave.c)
+ * and threads (wacky_parallel.c).
+ */
+
+void tests_wacky_container() {
+    printf("\n   - testing wacky_compress()/decompress()..........");
+
+    //T1 the layout is fixed byte for byte
+    size_t size;
+    uint8_t* container = wacky_compress((const uint8_t*)"aab", 3, &size);
+    uint8_t expected[42] = {'W', 'A', 'C', 'K', 1, 0, 3, 0, 0, 0, 0, 0, 0, 0,
+                            1, 1, 0};
+    expected[14 + 3 + 'a' / 8] = 0x06;
+    expected[14 + 19] = 1;
+    expected[14 + 19 + 8] = 0x04;
+    CHECK(container != NULL && size == sizeof(expected) &&
+          memcmp(container, expected, size) == 0, "T1");
+    free(container);
+
+    //T2 round trips, including the empty and single-symbol cases
+    const char* inputs[] = {JACK_AND_THE_BEANSTALK, "", "zzzzzzz"};
+    for (int i = 0; i < 3; i++) {
+        size_t length = strlen(inputs[i]);
+        container = wacky_compress((const uint8_t*)inputs[i], length, &size);
+        size_t decoded_length;
+        uint8_t* decoded = wacky_decompress(container, size, &decoded_length);
+        CHECK(decoded != NULL && decoded_length == length &&
+              memcmp(decoded, inputs[i], length) == 0, "T2");
+        free(decoded);
+        free(container);
+    }
+
+    //T3 truncated or damaged containers are rejected
+    container = wacky_compress((const uint8_t*)JACK_AND_THE_BEANSTALK,
+                               strlen(JACK_AND_THE_BEANSTALK), &size);
+    WackyContainer parsed;
+    assert(read_wacky_container(container, size, &parsed));
+    for (size_t cut = 0; cut < size; cut += 7) {
+        CHECK(!read_wacky_container(container, cut, &parsed), "T3");
+    }
+    container[4] = WACKY_CONTAINER_VERSION + 1;
+    CHECK(!read_wacky_container(container, size, &parsed), "T3");
+    container[4] = WACKY_CONTAINER_VERSION;
+
+    //T4 a symbol count the payload cannot hold is refused
+    int min_length = shortest_code_length(&parsed.codes);
+    size_t decoded_length;
+    store_le64(&container[6], parsed.payload_size * CHAR_BIT / min_length + 1);
+    CHECK(!read_wacky_container(container, size, &parsed) &&
+          wacky_decompress(container, size, &decoded_length) == NULL, "T4");
+    free(container);
+
+    printf("works.");
+}
+
+void tests_wacky_blocks() {
+    printf("\n   - testing wacky_compress_blocks()..........");
+
+    // Four letters, then every byte value, then the four letters again.
+    size_t length = 3 * 65536;
+    uint8_t* data = malloc(length);
+    srand(11);
+    for (size_t i = 0; i < length; i++) {
+        bool middle = i >= 65536 && i < 2 * 65536;
+        data[i] = middle ? rand() % 256 : "abcd"[rand() % 4];
+    }
+
+    //T1 a mixed input gets a table per kind of block and beats one tree
+    size_t size, tables, decoded_length;
+    uint8_t* blocks = wacky_compress_blocks(data, length, 16384, &size, &tables);
+    size_t single_size;
+    uint8_t* single = wacky_compress(data, length, &single_size);
+    CHECK(blocks != NULL && tables == 3 && size < single_size, "T1");
+
+    //T2 the blocks decode back to the input
+    uint8_t* decoded = wacky_decompress_blocks(blocks, size, &decoded_length);
+    CHECK(decoded != NULL && decoded_length == length &&
+          memcmp(decoded, data, length) == 0, "T2");
+    free(decoded);
+
+    //T3 truncated containers are rejected
+    for (size_t cut = 0; cut < size; cut += 997) {
+        CHECK(wacky_decompress_blocks(blocks, cut,
+                                      &decoded_length) == NULL, "T3");
+    }
+    free(blocks);
+    free(single);
+
+    //T4 a short last block and an empty input round trip too
+    length = strlen(JACK_AND_THE_BEANSTALK);
+    for (size_t n = 0; n <= length; n += length) {
+        blocks = wacky_compress_blocks((const uint8_t*)JACK_AND_THE_BEANSTALK, n,
+                                       1000, &size, &tables);
+        decoded = wacky_decompress_blocks(blocks, size, &decoded_length);
+        CHECK(decoded != NULL && decoded_length == n &&
+              memcmp(decoded, JACK_AND_THE_BEANSTALK, n) == 0, "T4");
+        free(decoded);
+        free(blocks);
+    }
+
+    //T5 hostile lengths are refused before anything is allocated
+    blocks = wacky_compress_blocks((const uint8_t*)JACK_AND_THE_BEANSTALK,
+                                   length, 1000, &size, &tables);
+    uint64_t hostile[] = {UINT64_MAX, UINT64_MAX - 998, (uint64_t)1 << 40};
+    for (int i = 0; i < 3; i++) {
+        store_le64(&blocks[6], hostile[i]);
+        CHECK(wacky_decompress_blocks(blocks, size, &decoded_length) == NULL,
+              "T5");
+    }
+    free(blocks);
+    free(data);
+
+    printf("works.");
+}
+
+void tests_wacky_order1() {
+    printf("\n   - testing wacky_compress_order1()/decompress_order1()..........");
+
+    //T1 the beanstalk text codes smaller than with one table
+    const uint8_t* text = (const uint8_t*)JACK_AND_THE_BEANSTALK;
+    size_t text_length = strlen(JACK_AND_THE_BEANSTALK);
+    size_t size, order0_size, decoded_length;
+    uint8_t* order0 = wacky_compress(text, text_length, &order0_size);
+    uint8_t* compressed = wacky_compress_order1(text, text_length, &size);
+    uint8_t* decoded = wacky_decompress_order1(compressed, size, &decoded_length);
+    CHECK(compressed != NULL && size < order0_size && decoded != NULL &&
+          decoded_length == text_length &&
+          memcmp(decoded, text, text_length) == 0, "T1");
+    free(order0);
+    free(compressed);
+    free(decoded);
+
+    //T2 empty, single-byte, single-symbol and all-byte inputs round trip
+    uint8_t data[3000];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i < 1000 ? 'z' : (i * 37 + i / 7) % 256;
+    }
+    const uint8_t* inputs[] = {data, data, data, &data[1000], data};
+    size_t lengths[] = {0, 1, 1000, 2000, 3000};
+    for (int i = 0; i < 5; i++) {
+        uint8_t* round = wacky_compress_order1(inputs[i], lengths[i], &size);
+        uint8_t* back = wacky_decompress_order1(round, size, &decoded_length);
+        CHECK(round != NULL && back != NULL && decoded_length == lengths[i] &&
+              memcmp(back, inputs[i], lengths[i]) == 0 &&
+              wacky_decompress(round, size, &decoded_length) == NULL, "T2");
+        free(round);
+        free(back);
+    }
+
+    //T3 truncated containers are refused
+    size = 0;
+    compressed = wacky_compress_order1(text, text_length, &size);
+    for (size_t cut = 0; cut < size; cut += 1 + cut / 4) {
+        CHECK(wacky_decompress_order1(compressed, cut,
+                                      &decoded_length) == NULL, "T3");
+    }
+
+    //T4 a length the payload cannot hold is refused
+    store_le64(&compressed[6], (uint64_t)size * CHAR_BIT + 1);
+    CHECK(wacky_decompress_order1(compressed, size,
+                                  &decoded_length) == NULL, "T4");
+    free(compressed);
+
+    printf("works.");
+}
+
+void tests_wacky_interleave() {
+    printf("\n   - testing encode_bytes_interleaved()/decode_bytes_interleaved()..........");
+
+    WackyTreeNode* tree = beanstalk_tree();
+    WackyCodeTable codes;
+    WackyDecodeTable table;
+    build_wacky_code_table(tree, &codes);
+    assert(build_wacky_decode_table(&codes, &table));
+    free_tree(tree);
+    const uint8_t* text = (const uint8_t*)JACK_AND_THE_BEANSTALK;
+    size_t text_length = strlen(JACK_AND_THE_BEANSTALK);
+    uint8_t encoded[8192];
+    uint8_t decoded[4096];
+    size_t size;
+
+    //T1 every stream count and length round trips, short ones included
+    size_t lengths[] = {0, 1, 3, 4, 5, 17, text_length};
+    for (int streams = 1; streams <= WACKY_MAX_INTERLEAVE_STREAMS; streams++) {
+        for (int i = 0; i < 7; i++) {
+            memset(decoded, 0, sizeof(decoded));
+            CHECK(encode_bytes_interleaved(&codes, text, lengths[i], streams,
+                                           encoded, sizeof(encoded), &size) &&
+                  size <= wacky_interleaved_bound(lengths[i], codes.max_length,
+                                                  streams) &&
+                  encoded[0] == streams &&
+                  decode_bytes_interleaved(&table, encoded, size, decoded,
+                                           lengths[i]) &&
+                  memcmp(decoded, text, lengths[i]) == 0, "T1");
+        }
+    }
+
+    //T2 the first stream is the plain stream of the first segment
+    uint8_t expected[4096];
+    size_t expected_size;
+    size_t segment = (text_length + 3) / 4;
+    assert(encode_bytes_interleaved(&codes, text, text_length, 4, encoded,
+                                    sizeof(encoded), &size));
+    assert(encode_bytes_to_stream(&codes, text, segment, expected,
+                                  sizeof(expected), &expected_size));
+    CHECK(read_le32(&encoded[1]) == expected_size &&
+          memcmp(&encoded[interleave_jump_table_size(4)], expected,
+                 expected_size) == 0, "T2");
+
+    //T3 bad stream counts, jump tables and truncated payloads are refused
+    uint8_t bad[8192];
+    memcpy(bad, encoded, size);
+    store_le32(&bad[1], (uint32_t)size);
+    CHECK(!encode_bytes_interleaved(&codes, text, text_length, 0, encoded,
+                                    sizeof(encoded), &size) &&
+          !encode_bytes_interleaved(&codes, text, text_length,
+                                    WACKY_MAX_INTERLEAVE_STREAMS + 1, encoded,
+                                    sizeof(encoded), &size) &&
+          !encode_bytes_interleaved(&codes, text, text_length, 4, encoded, 100,
+                                    &size) &&
+          !decode_bytes_interleaved(&table, bad, size, decoded, text_length) &&
+          !decode_bytes_interleaved(&table, encoded, size - 1, decoded,
+                                    text_length) &&
+          !decode_bytes_interleaved(&table, encoded, 3, decoded,
+                                    text_length), "T3");
+    bad[0] = 0;
+    CHECK(!decode_bytes_interleaved(&table, bad, size, decoded,
+                                    text_length), "T3");
+    free_wacky_decode_table(&table);
+
+    //T4 long inputs round trip with codes both within and past the root table
+    size_t long_length = 100000;
+    uint8_t* data = malloc(long_length);
+    uint8_t* packed = malloc(long_length * 4);
+    uint8_t* unpacked = malloc(long_length);
+    uint64_t counts[256];
+    assert(data != NULL && packed != NULL && unpacked != NULL);
+    srand(21);
+    for (size_t i = 0; i < long_length; i++) {
+        // Skewed, so the unlimited code runs well past the root width.
+        data[i] = (uint8_t)(rand() % 256 & rand() % 256 & rand() % 256);
+    }
+    compute_byte_histogram(counts, data, long_length);
+    int limits[] = {WACKY_INTERLEAVE_MAX_LENGTH, WACKY_MAX_DECODE_LENGTH};
+    for (int l = 0; l < 2; l++) {
+        assert(build_canonical_byte_table(counts, limits[l], &codes));
+        assert(build_wacky_decode_table(&codes, &table));
+        for (int streams = 1; streams <= 8; streams++) {
+            CHECK(encode_bytes_interleaved(&codes, data, long_length, streams,
+                                           packed, long_length * 4, &size) &&
+                  decode_bytes_interleaved(&table, packed, size, unpacked,
+                                           long_length) &&
+                  memcmp(unpacked, data, long_length) == 0, "T4");
+        }
+        free_wacky_decode_table(&table);
+    }
+    free(data);
+    free(packed);
+    free(unpacked);
+
+    printf("works.");
+}
+
+void tests_wacky_parallel() {
+    printf("\n   - testing wacky_parallel_encode()/decode()..........");
+
+    WackyParallelEncoding encoding;
+    //T1
+    CHECK(!wacky_parallel_encode(NULL, 10, 0, 2, &encoding) &&
+          !wacky_parallel_encode((const uint8_t*)"a", 0, 0, 2,
+                                 &encoding), "T1");
+
+    //T2 odd chunk sizes and thread counts all round-trip
+    size_t length = 50000;
+    uint8_t* data = malloc(length);
+    uint8_t* decoded = malloc(length);
+    size_t text_length = strlen(JACK_AND_THE_BEANSTALK);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = (i % 11 == 0) ? i % 256
+                                : (uint8_t)JACK_AND_THE_BEANSTALK[i % text_length];
+    }
+    size_t chunk_sizes[4] = {1, 777, 4096, 1 << 20};
+    for (int c = 0; c < 4; c++) {
+        for (int threads = 1; threads <= 5; threads += 2) {
+            if (chunk_sizes[c] == 1 && threads > 1) {
+                continue;
+            }
+            assert(wacky_parallel_encode(data, length, chunk_sizes[c], threads,
+                                         &encoding));
+            memset(decoded, 0, length);
+            CHECK(encoding.chunk_count ==
+                      (length + chunk_sizes[c] - 1) / chunk_sizes[c] &&
+                  wacky_parallel_decode(&encoding, decoded, threads) &&
+                  memcmp(decoded, data, length) == 0, "T2");
+            free_wacky_parallel_encoding(&encoding);
+        }
+    }
+
+    //T3 a single repeated byte
+    memset(data, 'z', length);
+    assert(wacky_parallel_encode(data, length, 1000, 0, &encoding));
+    CHECK(encoding.payload_size == 0 &&
+          wacky_parallel_decode(&encoding, decoded, 0) &&
+          memcmp(decoded, data, length) == 0, "T3");
+    free_wacky_parallel_encoding(&encoding);
+    free(data);
+    free(decoded);
+
+    printf("works.");
+}
+
+/**
+ * Streams: framed streams (wacky_stream.c) and adaptive coding
+ * (wacky_adaptive.c).
+ */
+
+/**
+ * Runs a whole buffer through a stream encoder, `window` bytes of input and
+ * output at a time, or everything at once when `window` is 0.
+ */
+size_t stream_encode_all(const WackyCodeTable* codes, const uint8_t* data,
+                         size_t length, uint8_t* stream, size_t capacity,
+                         size_t window) {
+    WackyStreamEncoder encoder;
+    wacky_stream_encoder_init(&encoder, codes);
+    size_t fed = 0;
+    size_t stream_size = 0;
+    size_t written;
+    while (fed < length) {
+        size_t consumed;
+        size_t in_window = window == 0 ? length - fed : (size_t)rand() % window;
+        size_t out_window = window == 0 ? capacity - stream_size
+                                        : (size_t)rand() % window;
+        WackyStreamStatus status = wacky_stream_encode(
+            &encoder, &data[fed], MIN(length - fed, in_window), &consumed,
+            &stream[stream_size], MIN(capacity - stream_size, out_window),
+            &written);
+        assert(status != WACKY_STREAM_ERROR);
+        fed += consumed;
+        stream_size += written;
+    }
+    while (wacky_stream_encoder_finish(&encoder, &stream[stream_size], 1,
+                                       &written) != WACKY_STREAM_OK) {
+        stream_size += written;
+    }
+    stream_size += written;
+    assert(encoder.symbol_count == length &&
+           encoder.bytes_written == stream_size);
+    return stream_size;
+}
+
+void tests_wacky_stream() {
+    printf("\n   - testing wacky_stream_encode()/decode()..........");
+
+    WackyTreeNode* tree = skewed_tree(40);
+    WackyCodeTable codes;
+    WackyDecodeTable table;
+    build_wacky_code_table(tree, &codes);
+    // Codes up to 39 bits exercise the split path in the encoder.
+    assert(codes.max_length == 39);
+
+    size_t length = 5000;
+    uint8_t data[5000];
+    for (size_t i = 0; i < length; i++) {
+        data[i] = 'A' + (i * 7 + i / 13) % 40;
+    }
+    srand(7);
+    uint8_t expected[5000 * 5];
+    size_t expected_size = stream_encode_all(&codes, data, length, expected,
+                                             sizeof(expected), 0);
+
+    //T1 tiny, uneven input and output windows produce the same stream
+    uint8_t stream[5000 * 5];
+    size_t stream_size =
+        stream_encode_all(&codes, data, length, stream, sizeof(stream), 50);
+    CHECK(stream_size == expected_size &&
+          memcmp(stream, expected, stream_size) == 0, "T1");
+
+    //T2 each frame is a symbol count, a size and the plain bit stream
+    size_t position = 0;
+    size_t symbols_seen = 0;
+    int frame_count = 0;
+    uint8_t payload[WACKY_STREAM_FRAME_BYTES];
+    for (;;) {
+        uint64_t symbols, size;
+        size_t payload_size;
+        position += read_wacky_varint(&stream[position], stream_size - position,
+                                      &symbols);
+        if (symbols == 0) {
+            break;
+        }
+        position += read_wacky_varint(&stream[position], stream_size - position,
+                                      &size);
+        assert(encode_bytes_to_stream(&codes, &data[symbols_seen], symbols,
+                                      payload, sizeof(payload), &payload_size));
+        CHECK(size == payload_size &&
+              memcmp(&stream[position], payload, size) == 0, "T2");
+        position += size;
+        symbols_seen += symbols;
+        frame_count++;
+    }
+    CHECK(position == stream_size && symbols_seen == length &&
+          frame_count >= 2, "T2");
+
+    //T3 codes longer than the decoder supports are refused
+    CHECK(!build_wacky_decode_table(&codes, &table), "T3");
+    free_tree(tree);
+
+    //T4 decoding in uneven pieces needs no symbol count and stops at the end
+    tree = beanstalk_tree();
+    build_wacky_code_table(tree, &codes);
+    assert(build_wacky_decode_table(&codes, &table));
+    length = strlen(JACK_AND_THE_BEANSTALK);
+    stream_size = stream_encode_all(&codes,
+                                    (const uint8_t*)JACK_AND_THE_BEANSTALK,
+                                    length, stream, sizeof(stream), 0);
+    // Whatever follows the stream is left alone.
+    stream[stream_size] = 0xFF;
+    uint8_t decoded[4096];
+    size_t decoded_size = 0;
+    size_t fed = 0;
+    size_t written;
+    WackyStreamDecoder decoder;
+    wacky_stream_decoder_init(&decoder, &table);
+    WackyStreamStatus status = WACKY_STREAM_OK;
+    while (status != WACKY_STREAM_DONE) {
+        size_t consumed;
+        status = wacky_stream_decode(
+            &decoder, &stream[fed],
+            MIN(stream_size + 1 - fed, (size_t)rand() % 5), &consumed,
+            &decoded[decoded_size], rand() % 7, &written);
+        assert(status != WACKY_STREAM_ERROR);
+        fed += consumed;
+        decoded_size += written;
+    }
+    CHECK(fed == stream_size && decoded_size == length &&
+          memcmp(decoded, JACK_AND_THE_BEANSTALK, length) == 0, "T4");
+
+    //T5 a flush makes everything encoded so far decodable
+    WackyStreamEncoder encoder;
+    wacky_stream_encoder_init(&encoder, &codes);
+    size_t consumed;
+    wacky_stream_encode(&encoder, (const uint8_t*)JACK_AND_THE_BEANSTALK, 100,
+                        &consumed, stream, sizeof(stream), &stream_size);
+    assert(consumed == 100);
+    assert(wacky_stream_encoder_flush(&encoder, &stream[stream_size],
+                                      sizeof(stream) - stream_size,
+                                      &written) == WACKY_STREAM_OK);
+    stream_size += written;
+    wacky_stream_decoder_init(&decoder, &table);
+    status = wacky_stream_decode(&decoder, stream, stream_size, &consumed,
+                                 decoded, sizeof(decoded), &decoded_size);
+    CHECK(status == WACKY_STREAM_OK && consumed == stream_size &&
+          decoded_size == 100 &&
+          memcmp(decoded, JACK_AND_THE_BEANSTALK, 100) == 0, "T5");
+
+    //T6 a frame whose size is too small for its symbols is an error
+    stream_size = stream_encode_all(&codes,
+                                    (const uint8_t*)JACK_AND_THE_BEANSTALK, 100,
+                                    stream, sizeof(stream), 0);
+    stream[1] = 1;
+    wacky_stream_decoder_init(&decoder, &table);
+    status = wacky_stream_decode(&decoder, stream, stream_size, &consumed,
+                                 decoded, sizeof(decoded), &written);
+    CHECK(status == WACKY_STREAM_ERROR, "T6");
+    free_wacky_decode_table(&table);
+    free_tree(tree);
+
+    printf("works.");
+}
+
+void tests_wacky_adaptive() {
+    printf("\n   - testing wacky_adaptive_encode()/decode()..........");
+
+    // Two halves with different statistics, long enough for the counts to
+    // be halved several times.
+    size_t length = 3 * 1000 * 1000;
+    uint8_t* data = malloc(length);
+    uint8_t* encoded = malloc(length);
+    uint8_t* decoded = malloc(length);
+    assert(data != NULL && encoded != NULL && decoded != NULL);
+    size_t text_length = strlen(JACK_AND_THE_BEANSTALK);
+    srand(11);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = i < length / 2 ? JACK_AND_THE_BEANSTALK[i % text_length]
+                                 : 200 + rand() % (1 + rand() % 50);
+    }
+
+    //T1 uneven input and output windows round trip
+    WackyAdaptiveEncoder encoder;
+    assert(wacky_adaptive_encoder_init(&encoder));
+    size_t fed = 0, encoded_size = 0, consumed, written;
+    while (fed < length) {
+        WackyStreamStatus status = wacky_adaptive_encode(
+            &encoder, &data[fed], MIN(length - fed, (size_t)rand() % 5000),
+            &consumed, &encoded[encoded_size],
+            MIN(length - encoded_size, (size_t)rand() % 900), &written);
+        assert(status != WACKY_STREAM_ERROR);
+        fed += consumed;
+        encoded_size += written;
+    }
+    assert(wacky_adaptive_encoder_finish(&encoder, &encoded[encoded_size],
+                                         length - encoded_size,
+                                         &written) == WACKY_STREAM_OK);
+    encoded_size += written;
+
+    WackyAdaptiveDecoder decoder;
+    assert(wacky_adaptive_decoder_init(&decoder));
+    size_t decoded_size = 0;
+    fed = 0;
+    WackyStreamStatus status = WACKY_STREAM_OK;
+    while (status != WACKY_STREAM_DONE) {
+        status = wacky_adaptive_decode(
+            &decoder, &encoded[fed], MIN(encoded_size - fed, (size_t)rand() % 700),
+            &consumed, &decoded[decoded_size],
+            MIN(length - decoded_size, (size_t)rand() % 3000), &written);
+        assert(status != WACKY_STREAM_ERROR);
+        fed += consumed;
+        decoded_size += written;
+    }
+    wacky_adaptive_decoder_free(&decoder);
+    CHECK(encoder.symbol_count == length &&
+          encoder.bytes_written == encoded_size && decoded_size == length &&
+          memcmp(decoded, data, length) == 0, "T1");
+
+    //T2 a single pass comes close to two passes with one static tree
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    compute_byte_histogram(counts, data, length);
+    WackyCodeTable table;
+    assert(build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH, &table));
+    uint64_t static_size = count_encoded_bits(&table, counts) / CHAR_BIT;
+    CHECK(encoded_size <= static_size + static_size / 20, "T2");
+
+    //T3 a corrupt stream does not decode to the input
+    encoded[encoded_size / 2] ^= 0x5a;
+    assert(wacky_adaptive_decoder_init(&decoder));
+    status = wacky_adaptive_decode(&decoder, encoded, encoded_size, &consumed,
+                                   decoded, length, &written);
+    wacky_adaptive_decoder_free(&decoder);
+    CHECK(status != WACKY_STREAM_DONE ||
+          memcmp(decoded, data, length) != 0, "T3");
+    free(data);
+    free(encoded);
+    free(decoded);
+
+    printf("works.");
+}
+
+/**
+ * Shared codes: messages (wacky_context.c), batches (wacky_batch.c),
+ * dictionaries (wacky_train.c) and static codecs (wacky_generate.c).
+ */
+
+void tests_wacky_context() {
+    printf("\n   - testing wacky_encode_message()/decode_message()..........");
+
+    //T1 varints
+    uint64_t values[] = {0, 1, 127, 128, 300, (uint64_t)1 << 35, UINT64_MAX};
+    uint8_t varint[WACKY_MAX_VARINT_SIZE];
+    for (int i = 0; i < 7; i++) {
+        uint64_t value;
+        size_t size = write_wacky_varint(values[i], varint, sizeof(varint));
+        CHECK(size != 0 && read_wacky_varint(varint, size, &value) == size &&
+              value == values[i] &&
+              !read_wacky_varint(varint, size - 1, &value), "T1");
+    }
+
+    //T2 many messages through one pair of contexts and the same buffers
+    WackyTreeNode* tree = beanstalk_tree();
+    WackyEncoderContext encoder;
+    WackyDecoderContext decoder;
+    assert(wacky_encoder_init(&encoder, tree));
+    free_tree(tree);
+    assert(wacky_decoder_init(&decoder, &encoder.codes));
+    const uint8_t* text = (const uint8_t*)JACK_AND_THE_BEANSTALK;
+    size_t text_length = strlen(JACK_AND_THE_BEANSTALK);
+    uint8_t message[1024];
+    uint8_t decoded[300];
+    srand(5);
+    for (int round = 0; round < 2000; round++) {
+        size_t length = rand() % 300;
+        size_t start = rand() % (text_length - length);
+        size_t size = wacky_encode_message(&encoder, &text[start], length,
+                                           message, sizeof(message));
+        size_t decoded_length;
+        CHECK(size != 0 && size <= wacky_message_bound(&encoder, length) &&
+              wacky_decode_message(&decoder, message, size, decoded,
+                                   sizeof(decoded), &decoded_length) &&
+              decoded_length == length &&
+              memcmp(decoded, &text[start], length) == 0, "T2");
+    }
+
+    //T3 short buffers and unknown bytes are refused
+    size_t decoded_length;
+    size_t size = wacky_encode_message(&encoder, text, 200, message,
+                                       sizeof(message));
+    CHECK(!wacky_decode_message(&decoder, message, size, decoded, 199,
+                                &decoded_length) &&
+          wacky_encode_message(&encoder, text, 200, message, size - 1) == 0 &&
+          wacky_encode_message(&encoder, (const uint8_t*)"\x01", 1, message,
+                               sizeof(message)) == 0, "T3");
+    wacky_decoder_free(&decoder);
+
+    printf("works.");
+}
+
+void tests_wacky_batch() {
+    printf("\n   - testing wacky_compress_batch()/decode_batch()..........");
+
+    WackyTreeNode* tree = beanstalk_tree();
+    WackyEncoderContext encoder;
+    WackyDecoderContext decoder;
+    assert(wacky_encoder_init(&encoder, tree));
+    free_tree(tree);
+    assert(wacky_decoder_init(&decoder, &encoder.codes));
+    const uint8_t* text = (const uint8_t*)JACK_AND_THE_BEANSTALK;
+    size_t text_length = strlen(JACK_AND_THE_BEANSTALK);
+
+    //T1 many short records, empty ones included, round trip in one batch
+    size_t count = 1000;
+    WackyRecord records[1000];
+    size_t total = 0;
+    srand(13);
+    for (size_t i = 0; i < count; i++) {
+        records[i].length = rand() % 40;
+        records[i].data = &text[rand() % (text_length - records[i].length)];
+        total += records[i].length;
+    }
+    wacky_reset_stats();
+    size_t size;
+    uint8_t* batch = wacky_compress_batch(&encoder, records, count, &size);
+    WackyStats stats;
+    wacky_get_stats(&stats);
+    uint8_t* decoded = malloc(total);
+    WackyRecord decoded_records[1000];
+    size_t decoded_count, decoded_total;
+    CHECK(batch != NULL &&
+          size <= wacky_batch_bound(&encoder, records, count) &&
+          (!wacky_stats_enabled() || stats.allocations == 1) &&
+          wacky_read_batch_size(batch, size, &decoded_count, &decoded_total) &&
+          decoded_count == count && decoded_total == total &&
+          wacky_decode_batch(&decoder, batch, size, decoded, total,
+                             decoded_records, count, &decoded_count) &&
+          decoded_count == count, "T1");
+    for (size_t i = 0; i < count; i++) {
+        CHECK(decoded_records[i].length == records[i].length &&
+              memcmp(decoded_records[i].data, records[i].data,
+                     records[i].length) == 0, "T1");
+    }
+
+    //T2 the record table is followed by one stream of all the records, which
+    // is smaller than coding each record as a message
+    uint8_t* joined = malloc(total);
+    uint8_t* expected = malloc(size);
+    size_t position = write_wacky_varint(count, expected, size);
+    size_t messages_size = 0;
+    uint8_t message[64];
+    for (size_t i = 0, at = 0; i < count; i++) {
+        position += write_wacky_varint(records[i].length, &expected[position],
+                                       size - position);
+        memcpy(&joined[at], records[i].data, records[i].length);
+        at += records[i].length;
+        messages_size += wacky_encode_message(&encoder, records[i].data,
+                                              records[i].length, message,
+                                              sizeof(message));
+    }
+    size_t stream_size;
+    CHECK(encode_bytes_to_stream(&encoder.codes, joined, total,
+                                 &expected[position], size - position,
+                                 &stream_size) &&
+          position + stream_size == size &&
+          memcmp(batch, expected, size) == 0 && size < messages_size, "T2");
+    free(joined);
+    free(expected);
+
+    //T3 short buffers, corrupt headers and unknown bytes are refused
+    uint8_t corrupt[3] = {2, 5, 0x80};
+    CHECK(!wacky_decode_batch(&decoder, batch, size, decoded, total - 1,
+                              decoded_records, count, &decoded_count) &&
+          !wacky_decode_batch(&decoder, batch, size, decoded, total,
+                              decoded_records, count - 1, &decoded_count) &&
+          !wacky_decode_batch(&decoder, batch, size - 1, decoded, total,
+                              decoded_records, count, &decoded_count) &&
+          !wacky_read_batch_size(corrupt, sizeof(corrupt), &decoded_count,
+                                 &decoded_total) &&
+          wacky_encode_batch(&encoder, records, count, batch,
+                             size - 1) == 0, "T3");
+    records[7].data = (const uint8_t*)"\x01";
+    records[7].length = 1;
+    CHECK(wacky_encode_batch(&encoder, records, 8, batch, size) == 0 &&
+          wacky_compress_batch(&encoder, records, count, &size) == NULL, "T3");
+    free(batch);
+    free(decoded);
+    wacky_decoder_free(&decoder);
+
+    printf("works.");
+}
+
+void tests_wacky_train() {
+    printf("\n   - testing wacky_trainer_build_table()..........");
+
+    //T1 training over many samples covers every byte within the limit
+    WackyTrainer trainer;
+    wacky_trainer_init(&trainer);
+    const uint8_t* text = (const uint8_t*)JACK_AND_THE_BEANSTALK;
+    size_t text_length = strlen(JACK_AND_THE_BEANSTALK);
+    for (size_t start = 0; start < text_length; start += 100) {
+        wacky_trainer_add(&trainer, &text[start], MIN(100, text_length - start));
+    }
+    WackyCodeTable table;
+    CHECK(trainer.byte_count == text_length &&
+          wacky_trainer_build_table(&trainer, 12, true, &table) &&
+          table.max_length == 12, "T1");
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        CHECK(table.codes[i].length >= 1, "T1");
+    }
+
+    //T2 the dictionary file round trips
+    const char* path = "wacky_tests.dict";
+    WackyCodeTable loaded;
+    CHECK(wacky_save_dictionary(path, &table) &&
+          wacky_load_dictionary(path, &loaded) &&
+          loaded.max_length == table.max_length, "T2");
+    remove(path);
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        CHECK(loaded.codes[i].length == table.codes[i].length &&
+              loaded.codes[i].bits == table.codes[i].bits, "T2");
+    }
+
+    //T3 contexts from the dictionary code bytes never seen in training
+    WackyEncoderContext encoder;
+    WackyDecoderContext decoder;
+    assert(wacky_encoder_init_from_table(&encoder, &loaded));
+    assert(wacky_decoder_init(&decoder, &loaded));
+    uint8_t message[] = "Jack\xff\x01 and the beanstalk";
+    uint8_t encoded[128], decoded[64];
+    size_t size = wacky_encode_message(&encoder, message, sizeof(message),
+                                       encoded, sizeof(encoded));
+    size_t decoded_length;
+    CHECK(size != 0 &&
+          wacky_decode_message(&decoder, encoded, size, decoded,
+                               sizeof(decoded), &decoded_length) &&
+          decoded_length == sizeof(message) &&
+          memcmp(decoded, message, sizeof(message)) == 0, "T3");
+    wacky_decoder_free(&decoder);
+
+    //T4 damaged dictionaries are refused
+    uint8_t dictionary[WACKY_MAX_DICTIONARY_SIZE];
+    size = write_wacky_dictionary(&table, dictionary, sizeof(dictionary));
+    dictionary[0] = 'X';
+    CHECK(size != 0 && read_wacky_dictionary(dictionary, size, &loaded) == 0 &&
+          !wacky_load_dictionary("no/such/file.dict", &loaded), "T4");
+
+    printf("works.");
+}
+
+void tests_static_codec() {
+    printf("\n   - testing write_static_codec()..........");
+
+    //T1 the generated beanstalk codec holds the table train builds
+    const uint8_t* text = (const uint8_t*)JACK_AND_THE_BEANSTALK;
+    size_t text_length = strlen(JACK_AND_THE_BEANSTALK);
+    WackyTrainer trainer;
+    wacky_trainer_init(&trainer);
+    wacky_trainer_add(&trainer, text, text_length);
+    WackyCodeTable codes;
+    assert(wacky_trainer_build_table(&trainer, WACKY_MAX_DECODE_LENGTH, true,
+                                     &codes));
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        CHECK(wacky_beanstalk_code_lengths[i] == codes.codes[i].length &&
+              wacky_beanstalk_code_bits[i] == codes.codes[i].bits, "T1");
+    }
+
+    //T2 static and runtime streams are the same, and decode either way
+    uint8_t expected[4096], encoded[4096], decoded[4096];
+    size_t expected_size, size;
+    assert(encode_bytes_to_stream(&codes, text, text_length, expected,
+                                  sizeof(expected), &expected_size));
+    WackyDecodeTable table;
+    assert(build_wacky_decode_table(&codes, &table));
+    CHECK(wacky_beanstalk_encode(text, text_length, encoded,
+                                 wacky_beanstalk_bound(text_length), &size) &&
+          size == expected_size && memcmp(encoded, expected, size) == 0 &&
+          wacky_beanstalk_decode(encoded, size, decoded, text_length) &&
+          memcmp(decoded, text, text_length) == 0 &&
+          decode_bytes_with_table(&table, encoded, size, decoded,
+                                  text_length), "T2");
+    free_wacky_decode_table(&table);
+
+    //T3 short buffers and streams are refused
+    CHECK(!wacky_beanstalk_encode(text, text_length, encoded, size - 1,
+                                  &size) &&
+          !wacky_beanstalk_decode(encoded, expected_size / 2, decoded,
+                                  text_length), "T3");
+
+    //T4 the source is specialized to its table
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    counts['a'] = 5;
+    counts['b'] = 3;
+    counts['c'] = 1;
+    assert(build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH, &codes));
+    char source[16384];
+    FILE* file = fmemopen(source, sizeof(source), "w");
+    assert(file != NULL && write_static_codec(file, "abc", &codes, NULL));
+    fclose(file);
+    CHECK(strstr(source, "bool abc_decode(") != NULL &&
+          strstr(source, "abc_decode_slots[slot]") == NULL &&
+          strstr(source, "code_length == 255") != NULL, "T4");
+
+    printf("works.");
+}
+
+/**
+ * Statistics (wacky_stats.c). Runs last, over a fresh round trip.
+ */
+
+void tests_wacky_stats() {
+    printf("\n   - testing wacky_get_stats()..........");
+    wacky_reset_stats();
+    const uint8_t* data = (const uint8_t*)JACK_AND_THE_BEANSTALK;
+    size_t length = strlen(JACK_AND_THE_BEANSTALK);
+    size_t size, decoded_length;
+    uint8_t* compressed = wacky_compress(data, length, &size);
+    uint8_t* decompressed = wacky_decompress(compressed, size, &decoded_length);
+    assert(decompressed != NULL && decoded_length == length);
+    free(compressed);
+    free(decompressed);
+
+    WackyStats stats;
+    wacky_get_stats(&stats);
+
+    //T1 without -DWACKY_STATS nothing is counted
+    if (!wacky_stats_enabled()) {
+        WackyStats zero;
+        memset(&zero, 0, sizeof(zero));
+        CHECK(memcmp(&stats, &zero, sizeof(stats)) == 0, "T1");
+        printf("works.");
+        return;
+    }
+
+    //T2 the counters match one compress and decompress round trip
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE] = {0};
+    compute_byte_histogram(counts, data, length);
+    WackyCodeTable table;
+    assert(build_canonical_byte_table(counts, WACKY_MAX_DECODE_LENGTH, &table));
+    CHECK(stats.symbols_encoded == length && stats.symbols_decoded == length &&
+          stats.bits_emitted == count_encoded_bits(&table, counts) &&
+          stats.bytes_histogrammed == length && stats.allocations != 0 &&
+          stats.trees_built == 1 &&
+          stats.max_code_length == table.max_length, "T2");
+
+    //T3 codes are within one bit of the entropy, and every stage ran once
+    CHECK(stats.entropy > 0 && stats.average_code_length >= stats.entropy &&
+          stats.average_code_length <= stats.entropy + 1, "T3");
+    for (int i = 0; i < WACKY_STAGE_COUNT; i++) {
+        CHECK(stats.stage_calls[i] == 1, "T3");
+    }
+
+    //T4 resetting clears everything
+    wacky_reset_stats();
+    wacky_get_stats(&stats);
+    CHECK(stats.symbols_encoded == 0 &&
+          stats.stage_calls[WACKY_STAGE_ENCODE] == 0 &&
+          strcmp(wacky_stage_name(WACKY_STAGE_DECODE_TABLE),
+                 "decode_table") == 0, "T4");
+
+    printf("works.");
+}
+
+int main() {
+    printf("Running codec tests:");
+
+    tests_build_wacky_tree();
+    tests_wacky_arena();
+    tests_flat_tree();
+    tests_length_limit();
+
+    tests_bit_writer();
+    tests_build_wacky_code_table();
+    tests_encode_string_with_table();
+    tests_decode_ints_with_table();
+    tests_wacky_header();
+    tests_byte_alphabet();
+    tests_compute_byte_histogram();
+
+    tests_wacky_container();
+    tests_wacky_blocks();
+    tests_wacky_order1();
+    tests_wacky_interleave();
+    tests_wacky_parallel();
+
+    tests_wacky_stream();
+    tests_wacky_adaptive();
+
+    tests_wacky_context();
+    tests_wacky_batch();
+    tests_wacky_train();
+    tests_static_codec();
+
+    tests_wacky_stats();
+
+    printf("\nAll codec tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,173 @@
+#ifndef WACKY_TRAIN_C
+#define WACKY_TRAIN_C
+
+#include "wacky_context.c"
+#include "wacky_histogram.c"
+
+/**
+ * Training: histograms are gathered over any number of sample buffers or
+ * files and turned into one static code table, which is saved as a small
+ * dictionary file. Encoders and decoders load the dictionary at startup, so
+ * messages coded with it carry no header of their own.
+ *
+ * A dictionary file is:
+ *
+ *   bytes 0-3   magic "WKDT"
+ *   byte 4      format version (WACKY_DICTIONARY_VERSION)
+ *   byte 5      flags, reserved and 0
+ *   header      the code lengths, see write_wacky_header()
+ */
+
+#define WACKY_DICTIONARY_MAGIC "WKDT"
+#define WACKY_DICTIONARY_MAGIC_SIZE 4
+#define WACKY_DICTIONARY_VERSION 1
+#define WACKY_DICTIONARY_PREFIX_SIZE (WACKY_DICTIONARY_MAGIC_SIZE + 2)
+#define WACKY_MAX_DICTIONARY_SIZE \
+    (WACKY_DICTIONARY_PREFIX_SIZE + WACKY_MAX_HEADER_SIZE)
+#define WACKY_TRAIN_READ_SIZE ((size_t)64 << 10)
+
+typedef struct WackyTrainer WackyTrainer;
+struct WackyTrainer {
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE];
+    uint64_t sample_count;
+    uint64_t byte_count;
+};
+
+void wacky_trainer_init(WackyTrainer* trainer) {
+    memset(trainer, 0, sizeof(*trainer));
+}
+
+/**
+ * Adds one sample to the training histogram.
+ */
+void wacky_trainer_add(WackyTrainer* trainer, const uint8_t* data,
+                       size_t length) {
+    compute_byte_histogram(trainer->counts, data, length);
+    trainer->sample_count++;
+    trainer->byte_count += length;
+}
+
+/**
+ * Adds the whole contents of a file as one sample, reading it in pieces.
+ *
+ * @return false if the file cannot be opened or read.
+ */
+bool wacky_trainer_add_file(WackyTrainer* trainer, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    uint8_t* buffer = malloc(WACKY_TRAIN_READ_SIZE);
+    if (buffer == NULL) {
+        fclose(file);
+        return false;
+    }
+    WACKY_COUNT(WACKY_STAT_ALLOCATIONS, 1);
+    size_t read;
+    while ((read = fread(buffer, 1, WACKY_TRAIN_READ_SIZE, file)) > 0) {
+        compute_byte_histogram(trainer->counts, buffer, read);
+        trainer->byte_count += read;
+    }
+    bool ok = !ferror(file);
+    trainer->sample_count++;
+    free(buffer);
+    fclose(file);
+    return ok;
+}
+
+/**
+ * Builds the static table for everything added so far.
+ *
+ * @param trainer The trainer.
+ * @param max_length The longest code allowed; WACKY_MAX_DECODE_LENGTH or less
+ * keeps the table decodable.
+ * @param cover_all_bytes If true, bytes never seen in training still get a
+ * (long) code, as if seen once, so any message can be encoded.
+ * @param table The table to fill.
+ *
+ * @return false if nothing was seen or the bytes do not fit in `max_length`.
+ */
+bool wacky_trainer_build_table(WackyTrainer* trainer, int max_length,
+                               bool cover_all_bytes, WackyCodeTable* table) {
+    uint64_t counts[WACKY_BYTE_ALPHABET_SIZE];
+    for (int i = 0; i < WACKY_BYTE_ALPHABET_SIZE; i++) {
+        counts[i] = trainer->counts[i];
+        if (cover_all_bytes && counts[i] == 0) {
+            counts[i] = 1;
+        }
+    }
+    return build_canonical_byte_table(counts, max_length, table);
+}
+
+/**
+ * Serializes a canonical code table as a dictionary.
+ *
+ * @return The number of bytes written, or 0 if the table is empty or `out`
+ * is too small; WACKY_MAX_DICTIONARY_SIZE is always enough.
+ */
+size_t write_wacky_dictionary(WackyCodeTable* table, uint8_t* out,
+                              size_t capacity) {
+    if (table == NULL || out == NULL ||
+        capacity < WACKY_DICTIONARY_PREFIX_SIZE) {
+        return 0;
+    }
+    memcpy(out, WACKY_DICTIONARY_MAGIC, WACKY_DICTIONARY_MAGIC_SIZE);
+    out[4] = WACKY_DICTIONARY_VERSION;
+    out[5] = 0;
+    size_t header_size =
+        write_wacky_header(table, &out[WACKY_DICTIONARY_PREFIX_SIZE],
+                           capacity - WACKY_DICTIONARY_PREFIX_SIZE);
+    return header_size == 0 ? 0 : WACKY_DICTIONARY_PREFIX_SIZE + header_size;
+}
+
+/**
+ * Reads a dictionary written by write_wacky_dictionary().
+ *
+ * @return The number of bytes read, or 0 if it is not a valid dictionary.
+ */
+size_t read_wacky_dictionary(const uint8_t* in, size_t size,
+                             WackyCodeTable* table) {
+    if (in == NULL || table == NULL || size < WACKY_DICTIONARY_PREFIX_SIZE ||
+        memcmp(in, WACKY_DICTIONARY_MAGIC, WACKY_DICTIONARY_MAGIC_SIZE) != 0 ||
+        in[4] != WACKY_DICTIONARY_VERSION || in[5] != 0) {
+        return 0;
+    }
+    size_t header_size = read_wacky_header(&in[WACKY_DICTIONARY_PREFIX_SIZE],
+                                           size - WACKY_DICTIONARY_PREFIX_SIZE,
+                                           table);
+    return header_size == 0 ? 0 : WACKY_DICTIONARY_PREFIX_SIZE + header_size;
+}
+
+/**
+ * Writes a dictionary file.
+ *
+ * @return false if the table is empty or the file cannot be written.
+ */
+bool wacky_save_dictionary(const char* path, WackyCodeTable* table) {
+    uint8_t buffer[WACKY_MAX_DICTIONARY_SIZE];
+    size_t size = write_wacky_dictionary(table, buffer, sizeof(buffer));
+    FILE* file = size > 0 ? fopen(path, "wb") : NULL;
+    if (file == NULL) {
+        return false;
+    }
+    bool ok = fwrite(buffer, 1, size, file) == size;
+    return fclose(file) == 0 && ok;
+}
+
+/**
+ * Reads a dictionary file.
+ *
+ * @return false if the file cannot be read or is not a valid dictionary.
+ */
+bool wacky_load_dictionary(const char* path, WackyCodeTable* table) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    uint8_t buffer[WACKY_MAX_DICTIONARY_SIZE];
+    size_t size = fread(buffer, 1, sizeof(buffer), file);
+    fclose(file);
+    return read_wacky_dictionary(buffer, size, table) > 0;
+}
+
+#endif